@@ -0,0 +1,69 @@
+// SPDX-License-Identifier: Apache-2.0
+
+package chiselBenchmarks
+
+import firrtl.annotations.{Annotation, CircuitTarget, JsonProtocol}
+import firrtl.transforms.{DontTouchAnnotation, NoDedupAnnotation}
+import org.json4s.native.JsonMethods
+import org.json4s.native.Serialization
+
+import java.io.{File, PrintWriter}
+import java.nio.file.Files
+
+/** Measures the time and peak JVM heap usage of serializing and deserializing many annotations:
+  *   - `json4s`: the whole array is built as one json4s AST, and written as one String or parsed at once
+  *   - `streaming`: annotations are written one at a time with `JsonProtocol.serializeLazily`, and read one at a time
+  *     with `JsonProtocol.deserialize`
+  *
+  * Run with `sbt "chiselBenchmark/runMain chiselBenchmarks.AnnotationSerializationBenchmark [<output.tsv>]"`, see
+  * [[TabulatedBenchmark]].
+  */
+object AnnotationSerializationBenchmark extends TabulatedBenchmark {
+  val header = Seq("direction", "mode", "annotations", "duration_ns", "peak_memory_bytes")
+
+  val sizes = Seq(10000, 100000, 400000)
+
+  /** `count` annotations, most of which are on components, as for `dontTouch` */
+  def annotations(count: Int): Seq[Annotation] = {
+    val circuit = CircuitTarget("Top")
+    Seq.tabulate(count) { index =>
+      if (index % 16 == 0) NoDedupAnnotation(circuit.module(s"Leaf_$index"))
+      else DontTouchAnnotation(circuit.module("Top").ref(s"_GEN_$index"))
+    }
+  }
+
+  def run(row: Seq[Any] => Unit): Unit = {
+    val file = File.createTempFile("annotations", ".anno.json")
+    try {
+      sizes.foreach { size =>
+        val annos = annotations(size)
+        def report(direction: String, mode: String)(body: => Any): Unit = {
+          val measurement = measure(body)
+          row(Seq(direction, mode, size, measurement.durationNanos, measurement.peakMemoryBytes))
+        }
+
+        report("write", "json4s") {
+          val out = new PrintWriter(file)
+          try out.write(JsonProtocol.serialize(annos))
+          finally out.close()
+        }
+        report("write", "streaming") {
+          val out = new PrintWriter(file)
+          try JsonProtocol.serializeLazily(annos).foreach(out.write)
+          finally out.close()
+        }
+        report("read", "json4s") {
+          val json = new String(Files.readAllBytes(file.toPath()), "UTF-8")
+          JsonMethods.parse(json)
+          implicit val formats = JsonProtocol.jsonFormat(Seq(classOf[DontTouchAnnotation], classOf[NoDedupAnnotation]))
+          Serialization.read[List[Annotation]](json)
+        }
+        report("read", "streaming") {
+          JsonProtocol.deserialize(file)
+        }
+      }
+    } finally {
+      file.delete()
+    }
+  }
+}
@@ -0,0 +1,85 @@
+// SPDX-License-Identifier: Apache-2.0
+
+package chiselBenchmarks
+
+import chisel3._
+import chisel3.util.Counter
+import chisel3.testers.BasicTester
+
+/** A design whose size is controlled by a single parameter, with a single output so that none of its logic is optimized away.
+  */
+abstract class ScalableDesign extends Module {
+  val out = IO(Output(UInt(32.W)))
+}
+
+/** A register file of `width` elements which are updated every cycle.
+  */
+class WideVec(width: Int) extends ScalableDesign {
+  val elements = RegInit(VecInit(Seq.tabulate(width)(_.U(32.W))))
+  elements.zipWithIndex.foreach {
+    case (element, index) =>
+      element := element + elements((index + 1) % width)
+  }
+  out := elements.reduceTree(_ ^ _)
+}
+
+/** A chain of `depth` nested module instances, each of which adds a pipeline stage.
+  */
+class DeepHierarchy(depth: Int) extends ScalableDesign {
+  val in = IO(Input(UInt(32.W)))
+  if (depth == 0) {
+    out := RegNext(in, 0.U)
+  } else {
+    val child = Module(new DeepHierarchy(depth - 1))
+    child.in := RegNext(in + depth.U, 0.U)
+    out := child.out
+  }
+}
+
+/** `count` independent memories, each written and read every cycle.
+  */
+class ManyMems(count: Int) extends ScalableDesign {
+  val (cycle, _) = Counter(true.B, 64)
+  val reads = Seq.tabulate(count) { index =>
+    val mem = SyncReadMem(64, UInt(32.W))
+    mem.write(cycle, cycle + index.U)
+    mem.read(cycle - 1.U)
+  }
+  out := reads.reduce(_ ^ _)
+}
+
+object Designs {
+
+  /** A family of designs, each of which is instantiated at several sizes.
+    */
+  final case class Family(name: String, sizes: Seq[Int], generate: Int => ScalableDesign)
+
+  val families = Seq(
+    Family("WideVec", Seq(64, 256, 1024), new WideVec(_)),
+    Family("DeepHierarchy", Seq(8, 32, 128), new WrappedDeepHierarchy(_)),
+    Family("ManyMems", Seq(4, 16, 64), new ManyMems(_))
+  )
+
+  /** The number of cycles each design is simulated for. This is deliberately short, since the benchmark measures building a simulation rather than running it.
+    */
+  val cycles = 16
+}
+
+/** `DeepHierarchy` with its input tied off, so that all designs have the same interface.
+  */
+class WrappedDeepHierarchy(depth: Int) extends ScalableDesign {
+  val hierarchy = Module(new DeepHierarchy(depth))
+  hierarchy.in := 1.U
+  out := hierarchy.out
+}
+
+/** Runs `design` for `Designs.cycles` cycles, printing its output so that it is observable.
+  */
+class DesignTester(design: => ScalableDesign) extends BasicTester {
+  val dut = Module(design)
+  val (_, done) = Counter(true.B, Designs.cycles)
+  when(done) {
+    printf(cf"out=${dut.out}%x\n")
+    stop()
+  }
+}
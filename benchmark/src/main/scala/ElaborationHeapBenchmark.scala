@@ -0,0 +1,45 @@
+// SPDX-License-Identifier: Apache-2.0
+
+package chiselBenchmarks
+
+import chisel3._
+import chisel3.stage.ChiselGeneratorAnnotation
+import chisel3.util.log2Ceil
+
+/** A register file of `entries` entries with one dynamically indexed write port and one dynamically indexed read port,
+  * whose first `staticEntries` entries are also each read individually.
+  */
+class RegisterFile(entries: Int, staticEntries: Int) extends ScalableDesign {
+  val addr = IO(Input(UInt(log2Ceil(entries).W)))
+  val in = IO(Input(UInt(32.W)))
+  val entry = Reg(Vec(entries, new Bundle { val valid = Bool(); val data = UInt(32.W) }))
+  entry(addr).valid := true.B
+  entry(addr).data := in
+  out := (0 until staticEntries).foldLeft(entry(addr).data) {
+    case (acc, index) => acc ^ Mux(entry(index).valid, entry(index).data, 0.U)
+  }
+}
+
+/** Measures the time and peak JVM heap usage of elaborating a register file, as a `Vec` of `Bundle`s:
+  *   - `dynamic`: every entry is only accessed with a hardware index, so almost none of its elements are created
+  *   - `static`: every entry is also accessed individually, so every element is created
+  *
+  * Run with `sbt "chiselBenchmark/runMain chiselBenchmarks.ElaborationHeapBenchmark [<output.tsv>]"`, see
+  * [[TabulatedBenchmark]].
+  */
+object ElaborationHeapBenchmark extends TabulatedBenchmark {
+  val header = Seq("mode", "entries", "duration_ns", "peak_memory_bytes")
+
+  val sizes = Seq(1024, 16384, 65536)
+
+  def run(row: Seq[Any] => Unit): Unit =
+    sizes.foreach { size =>
+      Seq("dynamic" -> 0, "static" -> size).foreach {
+        case (mode, staticEntries) =>
+          val measurement = measure {
+            ChiselGeneratorAnnotation(() => new RegisterFile(size, staticEntries)).elaborate
+          }
+          row(Seq(mode, size, measurement.durationNanos, measurement.peakMemoryBytes))
+      }
+    }
+}
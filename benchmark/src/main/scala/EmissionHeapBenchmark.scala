@@ -0,0 +1,67 @@
+// SPDX-License-Identifier: Apache-2.0
+
+package chiselBenchmarks
+
+import chisel3._
+import chisel3.stage.{ChiselGeneratorAnnotation, CircuitSerializationAnnotation}
+import chisel3.stage.phases.Convert
+import firrtl.ir.Serializer
+import firrtl.stage.FirrtlCircuitAnnotation
+
+/** A leaf module which is distinct from every other `ManyModulesLeaf`, so that each instance is a separate module in
+  * the emitted FIRRTL.
+  */
+class ManyModulesLeaf(index: Int) extends Module {
+  override def desiredName = s"Leaf_$index"
+  val in = IO(Input(UInt(32.W)))
+  val out = IO(Output(UInt(32.W)))
+  out := RegNext((in ^ index.U) + (in >> 1), 0.U)
+}
+
+/** A chain of `count` distinct modules.
+  */
+class ManyModules(count: Int) extends ScalableDesign {
+  out := (0 until count).foldLeft(1.U(32.W)) {
+    case (in, index) =>
+      val leaf = Module(new ManyModulesLeaf(index))
+      leaf.in := in
+      leaf.out
+  }
+}
+
+/** Measures the time and peak JVM heap usage of serializing the FIRRTL for designs with many modules:
+  *   - `direct`: serialized directly from the Chisel IR, without converting it to FIRRTL IR (the default)
+  *   - `streaming`: each module is converted to FIRRTL IR as it is serialized
+  *   - `materialized`: all modules are converted to FIRRTL IR before any are serialized
+  *
+  * All modes include the Chisel IR of the elaborated design, which is retained throughout.
+  *
+  * Run with `sbt "chiselBenchmark/runMain chiselBenchmarks.EmissionHeapBenchmark [<output.tsv>]"`, see
+  * [[TabulatedBenchmark]].
+  */
+object EmissionHeapBenchmark extends TabulatedBenchmark {
+  val header = Seq("mode", "modules", "duration_ns", "peak_memory_bytes", "emitted_chars")
+
+  val sizes = Seq(1000, 10000, 50000)
+
+  def run(row: Seq[Any] => Unit): Unit =
+    sizes.foreach { size =>
+      val circuit = (new Convert)
+        .transform(ChiselGeneratorAnnotation(() => new ManyModules(size)).elaborate)
+        .collectFirst { case FirrtlCircuitAnnotation(circuit) => circuit }
+        .get
+      Seq[(String, () => Iterable[String])](
+        "direct" -> (() => CircuitSerializationAnnotation.emitLazily(circuit, Nil)),
+        "streaming" -> (() => Serializer.lazily(circuit)),
+        "materialized" -> (() => Serializer.lazily(circuit.copy(modules = circuit.modules.toList)))
+      ).foreach {
+        case (mode, serialize) =>
+          val measurement = measure {
+            var length = 0L
+            serialize().foreach(chunk => length += chunk.length)
+            length
+          }
+          row(Seq(mode, size, measurement.durationNanos, measurement.peakMemoryBytes, measurement.result))
+      }
+    }
+}
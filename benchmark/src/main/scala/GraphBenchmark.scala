@@ -0,0 +1,71 @@
+// SPDX-License-Identifier: Apache-2.0
+
+package chiselBenchmarks
+
+import firrtl.graph.{CSRDiGraph, DiGraph, MutableDiGraph}
+
+import scala.util.Random
+
+/** Measures the time and peak JVM heap usage of graph algorithms on synthetic graphs, for each of `DiGraph` and
+  * `CSRDiGraph`:
+  *   - `hierarchy`: an instance graph, in which each module is instantiated by a random earlier module, and an eighth
+  *     of modules by a second one, so it is acyclic and shallow
+  *   - `random`: a graph with four random edges from each vertex, so most vertices are in one large SCC
+  *
+  * The operations are `build` (from edges), `reverse`, `findSCCs`, `reachableFrom` (vertex 0), and `paths` from
+  * vertex 0 (`pathsInDAG` for `DiGraph`, which is skipped for large graphs, and `countPathsInDAG` for `CSRDiGraph`).
+  *
+  * Run with `sbt "chiselBenchmark/runMain chiselBenchmarks.GraphBenchmark [<output.tsv>]"`, see [[TabulatedBenchmark]].
+  */
+object GraphBenchmark extends TabulatedBenchmark {
+  val header = Seq("graph", "representation", "operation", "vertices", "duration_ns", "peak_memory_bytes")
+
+  val sizes = Seq(10000, 100000, 1000000)
+
+  /** The largest graph for which every path is materialized */
+  val maxPathsInDAGSize = 100000
+
+  def hierarchy(random: Random, size: Int): Seq[(Int, Int)] =
+    (1 until size).flatMap { v =>
+      val parent = random.nextInt(v)
+      if (random.nextInt(8) == 0) Seq(parent -> v, random.nextInt(v) -> v) else Seq(parent -> v)
+    }
+
+  def randomEdges(random: Random, size: Int): Seq[(Int, Int)] =
+    (0 until size).flatMap(u => Seq.fill(4)(u -> random.nextInt(size)))
+
+  def run(row: Seq[Any] => Unit): Unit =
+    for (size <- sizes; (graph, edgesOf) <- Seq("hierarchy" -> hierarchy _, "random" -> randomEdges _)) {
+      val edges = edgesOf(new Random(0), size)
+      def report(representation: String, operation: String)(body: => Any): Unit = {
+        val measurement = measure(body)
+        row(Seq(graph, representation, operation, size, measurement.durationNanos, measurement.peakMemoryBytes))
+      }
+
+      var diGraph: DiGraph[Int] = null
+      report("DiGraph", "build") {
+        val mdg = new MutableDiGraph[Int]
+        (0 until size).foreach(mdg.addVertex)
+        edges.foreach { case (u, v) => mdg.addEdge(u, v) }
+        diGraph = mdg
+      }
+      report("DiGraph", "reverse")(diGraph.reverse)
+      report("DiGraph", "findSCCs")(diGraph.findSCCs)
+      report("DiGraph", "reachableFrom")(diGraph.reachableFrom(0))
+      if (graph == "hierarchy" && size <= maxPathsInDAGSize) {
+        report("DiGraph", "paths")(diGraph.pathsInDAG(0))
+      }
+      diGraph = null
+
+      var csrGraph: CSRDiGraph[Int] = null
+      report("CSRDiGraph", "build") {
+        csrGraph = CSRDiGraph(0 until size, edges)
+      }
+      report("CSRDiGraph", "reverse")(csrGraph.reverse)
+      report("CSRDiGraph", "findSCCs")(csrGraph.findSCCs)
+      report("CSRDiGraph", "reachableFrom")(csrGraph.reachableFrom(0))
+      if (graph == "hierarchy") {
+        report("CSRDiGraph", "paths")(csrGraph.countPathsInDAG(0))
+      }
+    }
+}
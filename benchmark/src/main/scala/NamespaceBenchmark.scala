@@ -0,0 +1,53 @@
+// SPDX-License-Identifier: Apache-2.0
+
+package chiselBenchmarks
+
+import chisel3._
+import chisel3.stage.ChiselGeneratorAnnotation
+
+/** A design with `count` wires, whose names are suggested by `nameOf`, so that they are all named by the same module
+  * namespace.
+  */
+class ManyNames(count: Int, nameOf: Int => String) extends ScalableDesign {
+  out := (0 until count).foldLeft(0.U(32.W)) {
+    case (acc, index) =>
+      val wire = Wire(UInt(32.W)).suggestName(nameOf(index))
+      wire := acc + 1.U
+      wire
+  }
+}
+
+/** Measures the time of elaborating designs whose names are adversarial for the module namespace:
+  *   - `distinct`: every name is unique, and does not end in a number
+  *   - `repeated`: every name is the same, so each is disambiguated with a new index
+  *   - `suffixed`: every name is unique, but ends in `_<index>`, so its prefix must be looked up
+  *   - `interleaved`: alternately the same name, and that name ending in `_<index>`, so that indices collide
+  *   - `nested`: every name is the previous name ending in `_1`, so that prefixes are long
+  *
+  * Run with `sbt "chiselBenchmark/runMain chiselBenchmarks.NamespaceBenchmark [<output.tsv>]"`, see
+  * [[TabulatedBenchmark]]. The time per name should not grow with the number of names.
+  */
+object NamespaceBenchmark extends TabulatedBenchmark {
+  val header = Seq("pattern", "names", "duration_ns", "ns_per_name")
+
+  val sizes = Seq(16384, 65536, 262144)
+
+  val patterns: Seq[(String, Int => String)] = Seq(
+    "distinct" -> (index => s"x${index}x"),
+    "repeated" -> (_ => "_T"),
+    "suffixed" -> (index => s"_GEN_${index}"),
+    "interleaved" -> (index => if (index % 2 == 0) "_T" else s"_T_${index}"),
+    "nested" -> (index => "_T" + "_1" * (index % 64))
+  )
+
+  def run(row: Seq[Any] => Unit): Unit =
+    sizes.foreach { size =>
+      patterns.foreach {
+        case (pattern, nameOf) =>
+          val durationNanos = measure {
+            ChiselGeneratorAnnotation(() => new ManyNames(size, nameOf)).elaborate
+          }.durationNanos
+          row(Seq(pattern, size, durationNanos, durationNanos / size))
+      }
+    }
+}
@@ -0,0 +1,50 @@
+// SPDX-License-Identifier: Apache-2.0
+
+package chiselBenchmarks
+
+import chisel3.simulator.EphemeralSimulator
+import chisel3.testers.TesterDriver
+import svsim.PhaseTiming
+
+import scala.collection.mutable.ArrayBuffer
+
+/** Measures how long it takes to build and run a simulation of designs of increasing size, broken down by stage (elaboration, `firtool`, Verilator, C++ compilation and simulation), for both `TesterDriver` and `EphemeralSimulator`.
+  *
+  * Run with `sbt "chiselBenchmark/runMain chiselBenchmarks.RegressionBuildBenchmark [<output.tsv>]"`, see [[TabulatedBenchmark]]. Each design additionally reports a `total` row, which is the only row to include the peak JVM heap usage.
+  */
+object RegressionBuildBenchmark extends TabulatedBenchmark {
+  val header = Seq("driver", "design", "size", "phase", "duration_ns", "allocated_bytes", "peak_memory_bytes")
+
+  def run(row: Seq[Any] => Unit): Unit =
+    for {
+      family <- Designs.families
+      size <- family.sizes
+    } {
+      def record(driver: String)(body: (PhaseTiming => Unit) => Unit): Unit = {
+        val timings = ArrayBuffer[PhaseTiming]()
+        val measurement = measure(body(timings += _))
+        timings.foreach { timing =>
+          val allocatedBytes = timing.allocatedBytes.getOrElse("")
+          row(Seq(driver, family.name, size, timing.name, timing.durationNanos, allocatedBytes, ""))
+        }
+        row(Seq(driver, family.name, size, "total", measurement.durationNanos, "", measurement.peakMemoryBytes))
+      }
+
+      record("TesterDriver") { report =>
+        val passed = TesterDriver.execute(
+          () => new DesignTester(family.generate(size)),
+          annotations = Seq(TesterDriver.PhaseTimingReporter(report))
+        )
+        require(passed, s"${family.name}($size) failed under TesterDriver")
+      }
+      record("EphemeralSimulator") { report =>
+        import EphemeralSimulator._
+        EphemeralSimulator
+          .simulateWithPhaseTimings(family.generate(size)) { dut =>
+            dut.clock.step(Designs.cycles)
+            dut.out.peek()
+          }
+          .foreach(report)
+      }
+    }
+}
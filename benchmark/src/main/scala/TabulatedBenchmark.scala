@@ -0,0 +1,57 @@
+// SPDX-License-Identifier: Apache-2.0
+
+package chiselBenchmarks
+
+import java.io.PrintWriter
+import java.lang.management.{ManagementFactory, MemoryType}
+import scala.collection.JavaConverters._
+
+/** A benchmark whose results are written as tab-separated values with a header row, to the file given as its only
+  * argument, or to `stdout` if no file is given.
+  *
+  * Peak heap usage includes garbage which has not yet been collected, so it is most meaningful with a small young
+  * generation (for example, `-Xmn32m`), and only because nothing else runs concurrently in the process.
+  */
+trait TabulatedBenchmark {
+  import TabulatedBenchmark.Measurement
+
+  /** The names of the columns of the results */
+  def header: Seq[String]
+
+  /** Runs the benchmark, calling `row` with the values of each row of results as soon as they are measured */
+  def run(row: Seq[Any] => Unit): Unit
+
+  def main(args: Array[String]): Unit = {
+    val writer = args.headOption match {
+      case Some(path) => new PrintWriter(path)
+      case None       => new PrintWriter(System.out)
+    }
+    try {
+      writer.println(header.mkString("\t"))
+      run { values =>
+        writer.println(values.mkString("\t"))
+        writer.flush()
+      }
+    } finally {
+      writer.close()
+    }
+  }
+
+  /** Runs `body` after collecting garbage, returning its result, how long it took, and the peak JVM heap usage while
+    * it ran
+    */
+  protected def measure[A](body: => A): Measurement[A] = {
+    val heapPools = ManagementFactory.getMemoryPoolMXBeans().asScala.filter(_.getType() == MemoryType.HEAP)
+    System.gc()
+    heapPools.foreach(_.resetPeakUsage())
+    val startTime = System.nanoTime()
+    val result = body
+    Measurement(result, System.nanoTime() - startTime, heapPools.map(_.getPeakUsage().getUsed()).sum)
+  }
+}
+
+object TabulatedBenchmark {
+
+  /** The result of a measured computation, see [[TabulatedBenchmark.measure]] */
+  final case class Measurement[A](result: A, durationNanos: Long, peakMemoryBytes: Long)
+}
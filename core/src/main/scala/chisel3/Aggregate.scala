@@ -25,6 +25,12 @@ class AliasedAggregateFieldException(message: String) extends chisel3.ChiselExce
   */
 sealed abstract class Aggregate extends Data {
 
+  // The Aggregate which this one was cloned from, directly or through other clones, by cloneTypeFull. Since clones
+  // have the same type as what they were cloned from, this is used to memoize type equivalence, see typeEquivalent.
+  private var _typePrototype: Aggregate = null // using nullable var for better memory usage
+  private[chisel3] def typePrototype: Aggregate = if (_typePrototype == null) this else _typePrototype
+  private[chisel3] def typePrototype_=(prototype: Aggregate): Unit = _typePrototype = prototype
+
   private def checkingLitOption(checkForDontCares: Boolean): Option[BigInt] = {
     // Shift the accumulated value by our width and add in our component, masked by our width.
     def shiftAdd(accumulator: Option[BigInt], elt: Data): Option[BigInt] = {
@@ -184,7 +190,7 @@ sealed class Vec[T <: Data] private[chisel3] (gen: => T, val length: Int) extend
 
     val resolvedDirection = SpecifiedDirection.fromParent(parentDirection, specifiedDirection)
     sample_element.bind(SampleElementBinding(this), resolvedDirection)
-    for (child <- elementsIterator) { // assume that all children are the same
+    foreachElement { child => // assume that all children are the same
       child.bind(ChildBinding(this), resolvedDirection)
     }
 
@@ -196,11 +202,44 @@ sealed class Vec[T <: Data] private[chisel3] (gen: => T, val length: Int) extend
   // Note: the constructor takes a gen() function instead of a Seq to enforce
   // that all elements must be the same and because it makes FIRRTL generation
   // simpler.
-  private lazy val self: Seq[T] = {
-    val _self = Vector.fill(length)(gen)
-    for ((elt, i) <- _self.zipWithIndex)
-      elt.setRef(this, i)
-    _self
+  //
+  // Elements are only created when they are first accessed, so large Vecs which are mostly indexed dynamically (for
+  // example, register files) never create most of their elements. Anything which must be done to every element, such
+  // as binding it, is recorded with foreachElement and done to each element as it is created.
+  private var createdElements: Array[Data] = null // using nullable var for better memory usage
+  private var elementInitializers: List[Data => Unit] = Nil // most recent first
+  // Every element, once all of them have been created by getElements
+  private var allElementsCreated: Vector[T] = null
+
+  private def element(index: Int): T = {
+    if (index < 0 || index >= length) {
+      throw new IndexOutOfBoundsException(s"$index is out of bounds (min 0, max ${length - 1})")
+    }
+    if (createdElements == null) {
+      createdElements = new Array[Data](length)
+    }
+    createdElements(index) match {
+      case null =>
+        val elt = gen
+        // Elements (and their children) belong to the same module as the Vec, regardless of which module first
+        // accesses them
+        elt.setAllParents(_parent)
+        elt.setRef(this, index)
+        createdElements(index) = elt
+        elementInitializers.reverseIterator.foreach(_(elt))
+        elt
+      case elt => elt.asInstanceOf[T]
+    }
+  }
+
+  /** Applies `f` to every element of this Vec: immediately to the elements which have already been created, and to
+    * the others when they are created
+    */
+  private[chisel3] def foreachElement(f: Data => Unit): Unit = {
+    elementInitializers = f :: elementInitializers
+    if (createdElements != null) {
+      createdElements.foreach { elt => if (elt != null) f(elt) }
+    }
   }
 
   /**
@@ -217,7 +256,7 @@ sealed class Vec[T <: Data] private[chisel3] (gen: => T, val length: Int) extend
   // to deprecate allElements in favor of dispatched functions to Data or
   // a pattern matched recursive descent
   private[chisel3] final override def allElements: Seq[Element] =
-    (sample_element +: self).flatMap(_.allElements)
+    (sample_element +: getElements).flatMap(_.allElements)
 
   /** The "bulk connect operator", assigning elements in this Vec from elements in a Seq.
     *
@@ -336,15 +375,21 @@ sealed class Vec[T <: Data] private[chisel3] (gen: => T, val length: Int) extend
 
   /** Creates a statically indexed read or write accessor into the array.
     */
-  def apply(idx: Int): T = self(idx)
+  def apply(idx: Int): T = element(idx)
 
   override def cloneType: this.type = {
     new Vec(gen.cloneTypeFull, length).asInstanceOf[this.type]
   }
 
-  override def getElements: Seq[Data] = self
+  override def getElements: Seq[Data] = {
+    if (allElementsCreated == null) {
+      allElementsCreated = Vector.tabulate(length)(element)
+    }
+    allElementsCreated
+  }
 
-  final override private[chisel3] def elementsIterator: Iterator[Data] = self.iterator
+  final override private[chisel3] def elementsIterator: Iterator[Data] =
+    if (allElementsCreated != null) allElementsCreated.iterator else Iterator.tabulate(length)(element)
 
   /** Default "pretty-print" implementation
     * Analogous to printing a Seq
@@ -353,7 +398,7 @@ sealed class Vec[T <: Data] private[chisel3] (gen: => T, val length: Int) extend
   def toPrintable: Printable = {
     val elts =
       if (length == 0) List.empty[Printable]
-      else self.flatMap(e => List(e.toPrintable, PString(", "))).dropRight(1)
+      else getElements.flatMap(e => List(e.toPrintable, PString(", "))).dropRight(1)
     PString("Vec(") + Printables(elts) + PString(")")
   }
 
@@ -564,7 +564,17 @@ abstract class Data extends HasId with NamedComponent with SourceInfoDoc {
     */
   private[chisel3] final def typeEquivalent(
     that: Data
-  ): Boolean = findFirstTypeMismatch(that, strictTypes = true, strictWidths = true).isEmpty
+  ): Boolean = (this, that) match {
+    // Aggregates have the same type as the Aggregates they were cloned from, so comparisons of large Aggregates (for
+    // example, in bulk connections between copies of a wide Bundle) are memoized by what they were cloned from
+    case (thiz: Aggregate, that: Aggregate) if Builder.hasDynamicContext =>
+      val key = (thiz.typePrototype, that.typePrototype)
+      (key._1 eq key._2) || Builder.typeEquivalence.getOrElseUpdate(
+        key,
+        findFirstTypeMismatch(that, strictTypes = true, strictWidths = true).isEmpty
+      )
+    case _ => findFirstTypeMismatch(that, strictTypes = true, strictWidths = true).isEmpty
+  }
 
   /** Find and report any type mismatches
     *
@@ -700,6 +710,8 @@ abstract class Data extends HasId with NamedComponent with SourceInfoDoc {
       data._parent = parent
       data match {
         case _:   Element =>
+        case vec: Vec[_] =>
+          vec.foreachElement(rec)
         case agg: Aggregate =>
           agg.elementsIterator.foreach(rec)
       }
@@ -730,6 +742,10 @@ abstract class Data extends HasId with NamedComponent with SourceInfoDoc {
     clone.specifiedDirection = specifiedDirection
     probe.setProbeModifier(clone, probeInfo)
     clone.isConst = isConst
+    (this, clone) match {
+      case (thiz: Aggregate, clone: Aggregate) => clone.typePrototype = thiz.typePrototype
+      case _ => // Elements are cheap to compare
+    }
     clone
   }
 
@@ -45,6 +45,8 @@ object Module extends SourceInfoDoc {
     Builder.currentClock = None
     Builder.currentReset = None
 
+    val elaboration = Builder.profiler.map(_.start())
+
     // Execute the module, this has the following side effects:
     //   - set currentModule
     //   - unset readyForModuleConstr
@@ -72,6 +74,7 @@ object Module extends SourceInfoDoc {
     for (component <- componentOpt) {
       Builder.components += component
     }
+    elaboration.foreach(_.finish(module, componentOpt))
 
     Builder.setPrefix(savePrefix)
 
@@ -127,7 +130,7 @@ object Module extends SourceInfoDoc {
               case record: Record =>
                 record.elementsIterator.foreach(assignCompatDir(_))
               case vec: Vec[_] =>
-                vec.elementsIterator.foreach(assignCompatDir(_))
+                vec.foreachElement(assignCompatDir(_))
                 assignCompatDir(vec.sample_element) // This is used in fromChildren computation
             }
           case SpecifiedDirection.Input | SpecifiedDirection.Output =>
@@ -147,11 +147,27 @@ object printf {
   ): Printf = {
     var printfId: Printf = null
     when(!Module.reset.asBool) {
-      printfId = printfWithoutReset(pable)
+      printfId = if (Builder.binaryPrintf) binaryPrintf(pable) else printfWithoutReset(pable)
     }
     printfId
   }
 
+  /** Lowers a printf to a binary record, which is formatted after simulation, see
+    * [[chisel3.stage.BinaryPrintfAnnotation]]
+    */
+  private def binaryPrintf(
+    pable: Printable
+  )(
+    implicit sourceInfo: SourceInfo
+  ): Printf = {
+    val printfId = new Printf(pable)
+
+    Printable.checkScope(pable)
+
+    BinaryPrintf(pable, Builder.forcedClock)
+    printfId
+  }
+
   private[chisel3] def printfWithoutReset(
     pable: Printable
   )(
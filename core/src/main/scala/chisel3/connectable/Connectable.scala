@@ -272,7 +272,11 @@ object Connectable {
       */
     final def :<=[S <: Data](lProducer: => S)(implicit evidence: T =:= S, sourceInfo: SourceInfo): Unit = {
       val producer = prefix(consumer.base) { lProducer }
-      connect(consumer, producer, ColonLessEq)
+      if (ColonLessEq.canFirrtlConnect(consumer, producer)) {
+        doFirrtlConnect(consumer.base, producer)
+      } else {
+        connect(consumer, producer, ColonLessEq)
+      }
     }
 
     /** $colonLessEq
@@ -282,7 +286,11 @@ object Connectable {
       */
     final def :<=[S <: Data](producer: Connectable[S])(implicit evidence: T =:= S, sourceInfo: SourceInfo): Unit = {
       prefix(consumer.base) {
-        connect(consumer, producer, ColonLessEq)
+        if (ColonLessEq.canFirrtlConnect(consumer, producer)) {
+          doFirrtlConnect(consumer.base, producer.base)
+        } else {
+          connect(consumer, producer, ColonLessEq)
+        }
       }
     }
 
@@ -360,7 +368,11 @@ object Connectable {
       */
     final def :#=[S <: Data](lProducer: => S)(implicit evidence: T =:= S, sourceInfo: SourceInfo): Unit = {
       val producer = prefix(consumer.base) { lProducer }
-      connect(consumer, producer, ColonHashEq)
+      if (ColonHashEq.canFirrtlConnect(consumer, producer)) {
+        doFirrtlConnect(consumer.base, producer)
+      } else {
+        connect(consumer, producer, ColonHashEq)
+      }
     }
 
     /** $colonHashEq
@@ -370,7 +382,11 @@ object Connectable {
       */
     final def :#=[S <: Data](producer: Connectable[S])(implicit evidence: T =:= S, sourceInfo: SourceInfo): Unit = {
       prefix(consumer.base) {
-        connect(consumer, producer, ColonHashEq)
+        if (ColonHashEq.canFirrtlConnect(consumer, producer)) {
+          doFirrtlConnect(consumer.base, producer.base)
+        } else {
+          connect(consumer, producer, ColonHashEq)
+        }
       }
     }
 
@@ -2,13 +2,15 @@
 
 package chisel3.connectable
 
-import chisel3.{Aggregate, BiConnectException, Data, DontCare, InternalErrorException, RawModule}
+import chisel3.{Aggregate, BiConnectException, Data, DontCare, InternalErrorException, RawModule, Record}
+import chisel3.SpecifiedDirection
 import chisel3.internal.{BiConnect, Builder}
 import chisel3.internal.Builder.pushCommand
-import chisel3.internal.firrtl.DefInvalid
+import chisel3.internal.firrtl.{Converter, DefInvalid}
 import chisel3.experimental.{prefix, SourceInfo, UnlocatableSourceInfo}
 import chisel3.experimental.{attach, Analog}
 import chisel3.reflect.DataMirror.hasProbeTypeModifier
+import firrtl.{ir => fir}
 import Alignment.matchingZipOfChildren
 
 import scala.collection.mutable
@@ -34,6 +36,8 @@ private[chisel3] case object ColonLessEq extends Connection {
   val connectToConsumer:       Boolean = true
   val connectToProducer:       Boolean = false
   val alwaysConnectToConsumer: Boolean = false
+  def canFirrtlConnect(consumer: Connectable[Data], producer: Connectable[Data]) =
+    Connection.canFirrtlConnectAligned(consumer, producer)
 }
 
 private[chisel3] case object ColonGreaterEq extends Connection {
@@ -83,6 +87,8 @@ private[chisel3] case object ColonHashEq extends Connection {
   val connectToConsumer:       Boolean = true
   val connectToProducer:       Boolean = false
   val alwaysConnectToConsumer: Boolean = true
+  def canFirrtlConnect(consumer: Connectable[Data], producer: Connectable[Data]) =
+    Connection.canFirrtlConnectAligned(consumer, producer)
 }
 
 private[chisel3] object Connection {
@@ -111,6 +117,33 @@ private[chisel3] object Connection {
     doConnection(cRoot, pRoot, cOp)
   }
 
+  /** Whether a one-directional connection from `producer` to `consumer` can be emitted as a single FIRRTL connect
+    *
+    * Without flipped members, every member is driven by the producer, just as in a FIRRTL connect.
+    */
+  def canFirrtlConnectAligned(consumer: Connectable[Data], producer: Connectable[Data]): Boolean =
+    ColonLessGreaterEq.canFirrtlConnect(consumer, producer) && isFullyAligned(consumer.base, producer.base)
+
+  /** Whether no member of `consumer` or `producer` is flipped relative to it */
+  def isFullyAligned(consumer: Data, producer: Data): Boolean = {
+    def rec(tpe: fir.Type): Boolean = tpe match {
+      case fir.BundleType(fields) => fields.forall(field => field.flip == fir.Default && rec(field.tpe))
+      case fir.VectorType(elt, _) => rec(elt)
+      case _                      => true
+    }
+    def aligned(data: Data): Boolean = data match {
+      // The direction of the element of an opaque type is not part of its FIRRTL type
+      case record: Record if record._isOpaqueType =>
+        val elt = record.elementsIterator.next()
+        (elt.specifiedDirection match {
+          case SpecifiedDirection.Unspecified | SpecifiedDirection.Output => true
+          case _                                                          => false
+        }) && aligned(elt)
+      case _ => rec(Converter.extractType(data, UnlocatableSourceInfo))
+    }
+    aligned(consumer) && aligned(producer)
+  }
+
   private def connect(
     l: Data,
     r: Data
@@ -29,6 +29,8 @@ import chisel3.internal.Builder
   * val inst2 = Instantiate(new OtherModule(3))
   * }}}
   *
+  * Definitions can also be kept across elaborations, see [[InstantiateCacheAnnotation]].
+  *
   * ==Limitations==
   *   - The caching does not work for Modules that are inner classes. This is due to the fact that
   *     the WeakTypeTags for instances will be different and thus will not hit in the cache.
@@ -121,10 +123,13 @@ object Instantiate {
     val key = CacheKey(boxAllData(args), tag)
     val defn = Builder.contextCache
       .getOrElseUpdate(
-        key, {
-          // The definition needs to have no source locator because otherwise it will be unstably
-          // derived from the first invocation of Instantiate for the particular Module
-          Definition.do_apply(f(args))(UnlocatableSourceInfo)
+        key,
+        Builder.instantiateCache match {
+          case Some(cache) => cache.getOrElseUpdate(key, f(args))
+          case None        =>
+            // The definition needs to have no source locator because otherwise it will be unstably
+            // derived from the first invocation of Instantiate for the particular Module
+            Definition.do_apply(f(args))(UnlocatableSourceInfo)
         }
       )
       .asInstanceOf[Definition[A]]
@@ -0,0 +1,59 @@
+// SPDX-License-Identifier: Apache-2.0
+
+package chisel3.experimental.hierarchy
+
+import chisel3.experimental.{BaseModule, UnlocatableSourceInfo}
+import chisel3.experimental.hierarchy.core.Definition
+import firrtl.annotations.NoTargetAnnotation
+import firrtl.options.Unserializable
+
+import scala.collection.mutable
+
+/** Keeps the [[Definition]]s built by [[Instantiate]] across the elaborations given this cache with an
+  * [[InstantiateCacheAnnotation]]
+  *
+  * When a later elaboration instantiates a module class with the same constructor arguments, the Definition from an
+  * earlier elaboration is added to it instead of being elaborated again. The result is exactly the same as
+  * elaborating it again: a Definition is only reused if every module in it would be given the same name, and is
+  * otherwise elaborated again.
+  *
+  * The cache is owned by the user, and keeps every Definition it holds (and the modules in it) until it is
+  * discarded. As with [[Instantiate]] itself, a module must only depend on its class and constructor arguments, and
+  * the cache should not be used by several elaborations at the same time.
+  *
+  * {{{
+  * val cache = new InstantiateCache
+  * configurations.foreach { configuration =>
+  *   (new ChiselStage).execute(
+  *     Array("--target", "systemverilog"),
+  *     Seq(ChiselGeneratorAnnotation(() => new SoC(configuration)), InstantiateCacheAnnotation(cache))
+  *   )
+  * }
+  * }}}
+  */
+final class InstantiateCache {
+  // The Definitions of each key, which may have been given different names in different elaborations
+  private val recorded = mutable.HashMap.empty[Any, List[Definition.Recorded[_ <: BaseModule]]]
+
+  /** Returns the Definition of the module with `key` (its class and arguments) from an earlier elaboration, adding it
+    * to this one, or otherwise builds it from `proto`
+    */
+  private[chisel3] def getOrElseUpdate[A <: BaseModule](key: Any, proto: => A): Definition[A] = {
+    val cached = synchronized { recorded.getOrElse(key, Nil) }.iterator
+      .map(_.asInstanceOf[Definition.Recorded[A]].adopt())
+      .collectFirst { case Some(definition) => definition }
+    cached.getOrElse {
+      // The definition needs to have no source locator because otherwise it will be unstably derived from the first
+      // invocation of Instantiate for the particular Module
+      val (definition, record) = Definition.record(proto)(UnlocatableSourceInfo)
+      synchronized { recorded(key) = record :: recorded.getOrElse(key, Nil) }
+      definition
+    }
+  }
+}
+
+/** Keeps the [[Definition]]s built by [[Instantiate]] in `cache`, see [[InstantiateCache]]
+  *
+  * @param cache the cache to keep Definitions in
+  */
+case class InstantiateCacheAnnotation(cache: InstantiateCache) extends NoTargetAnnotation with Unserializable
@@ -6,12 +6,14 @@ import scala.language.experimental.macros
 import chisel3._
 
 import scala.collection.mutable.HashMap
-import chisel3.internal.{Builder, DynamicContext}
+import chisel3.internal.{Builder, ChiselContext, DynamicContext, ElaborationProfiler, IdGen, Namespace}
+import chisel3.internal.firrtl.Circuit
 import chisel3.internal.sourceinfo.{DefinitionTransform, DefinitionWrapTransform}
 import chisel3.experimental.{BaseModule, SourceInfo}
 import firrtl.annotations.{IsModule, ModuleTarget, NoTargetAnnotation}
 
 import scala.annotation.nowarn
+import scala.util.{Success, Try}
 
 /** User-facing Definition type.
   * Represents a definition of an object of type `A` which are marked as @instantiable
@@ -99,17 +101,145 @@ object Definition extends SourceInfoDoc {
   )(
     implicit sourceInfo: SourceInfo
   ): Definition[T] = {
-    val dynamicContext = {
-      val context = Builder.captureContext()
-      new DynamicContext(Nil, context.throwOnFirstError, context.warningsAsErrors, context.sourceRoots)
+    val parent = Builder.captureContext()
+    val (ir, module, dynamicContext) = elaborate(proto, parent, Builder.globalNamespace, parent.profiler)
+    dynamicContext.globalNamespace.copyTo(Builder.globalNamespace)
+    adopt(ir, module)
+  }
+
+  /** A Definition which can be added to later elaborations, see [[chisel3.experimental.hierarchy.InstantiateCache]]
+    *
+    * @param names the names the Definition requested from the global namespace, in order
+    */
+  private[chisel3] class Recorded[T <: BaseModule with IsInstantiable] private[Definition] (
+    ir:     Circuit,
+    module: T,
+    names:  Seq[(String, Boolean, String)]) {
+
+    /** Adds the Definition to the current elaboration, if every name it was given is the name it would be given were
+      * it elaborated again, so that the result is exactly the same as elaborating it again
+      */
+    def adopt(): Option[Definition[T]] =
+      if (Builder.globalNamespace.accepts(names)) {
+        Builder.globalNamespace.replay(names)
+        Some(Definition.adopt(ir, module))
+      } else {
+        None
+      }
+  }
+
+  /** Builds a Definition like [[Definition.apply]], recording it so that it can be added to later elaborations */
+  private[chisel3] def record[T <: BaseModule with IsInstantiable](
+    proto: => T
+  )(
+    implicit sourceInfo: SourceInfo
+  ): (Definition[T], Recorded[T]) = {
+    val parent = Builder.captureContext()
+    val (ir, module, dynamicContext) = elaborate(proto, parent, Builder.globalNamespace.fork(), parent.profiler)
+    val names = dynamicContext.globalNamespace.requested
+    Builder.globalNamespace.replay(names)
+    (adopt(ir, module), new Recorded(ir, module, names))
+  }
+
+  /** Builds Definitions of several Modules, which may be elaborated concurrently
+    *
+    * The result is exactly the same as building each Definition in turn with [[Definition.apply]], including the
+    * names and order of all modules. If concurrent elaboration is enabled with
+    * `chisel3.stage.DefinitionThreadsAnnotation`, each Definition is speculatively elaborated on the elaboration's
+    * thread pool against a snapshot of the current namespaces. The results are then merged in order: a Definition is kept if every
+    * name it was given is the name it would have been given had it been elaborated serially, otherwise (or if its
+    * elaboration failed) it is elaborated again, serially, in its place.
+    *
+    * Every Definition built from a generator that has to be elaborated again is wasted work, so this works best for
+    * Definitions whose modules (and their submodules) have distinct names. The generators must not share mutable
+    * state, and may be run more than once. Definitions which are themselves being elaborated on the thread pool build
+    * their own Definitions serially.
+    *
+    * @param protos generators of the Modules being defined
+    *
+    * @return the Modules as Definitions, in the same order as their generators
+    */
+  def concurrently[T <: BaseModule with IsInstantiable](
+    protos: Seq[() => T]
+  )(
+    implicit sourceInfo: SourceInfo
+  ): Seq[Definition[T]] = {
+    val parent = Builder.captureContext()
+    val threads = parent.definitionThreadPool
+    if (!threads.available || protos.size <= 1) {
+      protos.map(proto => do_apply(proto()))
+    } else {
+      val firstId = Builder.idGen.value + 1
+      val speculations = protos.zipWithIndex.map {
+        case (proto, index) =>
+          // Each Definition gets its own range of ids, which preserves their relative order
+          val idGen = new IdGen(firstId + index * IdsPerSpeculation)
+          val chiselContext = new ChiselContext(idGen, Builder.viewNamespace.fork())
+          val globalNamespace = Builder.globalNamespace.fork()
+          val profiler = parent.profiler.map(_.fork())
+          val speculation = threads.submit { () =>
+            Builder.withChiselContext(chiselContext) {
+              elaborate(proto(), parent, globalNamespace, profiler, checkpoint = false)
+            }
+          }
+          (proto, chiselContext, profiler, speculation)
+      }
+      try {
+        speculations.map {
+          case (proto, chiselContext, profiler, speculation) =>
+            Try(parent.profiler.fold(speculation.get())(_.waitingFor(speculation.get()))) match {
+              case Success((ir, module, dynamicContext))
+                  if Builder.globalNamespace.accepts(dynamicContext.globalNamespace.requested) &&
+                    Builder.viewNamespace.accepts(chiselContext.viewNamespace.requested) =>
+                Builder.checkpoint(dynamicContext)
+                Builder.globalNamespace.replay(dynamicContext.globalNamespace.requested)
+                Builder.viewNamespace.replay(chiselContext.viewNamespace.requested)
+                Builder.idGen.advancePast(chiselContext.idGen.value)
+                for (parentProfiler <- parent.profiler; profiler <- profiler) parentProfiler.adopt(profiler)
+                adopt(ir, module)
+              case _ => do_apply(proto())
+            }
+        }
+      } finally {
+        // Speculations which are not needed, because an earlier Definition failed, are stopped
+        speculations.foreach { case (_, _, _, speculation) => speculation.cancel(true) }
+      }
     }
-    Builder.globalNamespace.copyTo(dynamicContext.globalNamespace)
+  }
+
+  // Far more ids than any single Definition could use
+  private val IdsPerSpeculation = 1L << 40
+
+  // Elaborates proto in a new DynamicContext, starting from a copy of globalNamespace
+  private def elaborate[T <: BaseModule](
+    proto:           => T,
+    parent:          DynamicContext,
+    globalNamespace: Namespace,
+    profiler:        Option[ElaborationProfiler],
+    checkpoint:      Boolean = true
+  ): (Circuit, T, DynamicContext) = {
+    val dynamicContext = new DynamicContext(
+      Nil,
+      parent.throwOnFirstError,
+      parent.warningsAsErrors,
+      parent.sourceRoots,
+      parent.definitionThreads
+    )
+    dynamicContext.definitionThreadPool = parent.definitionThreadPool
+    globalNamespace.copyTo(dynamicContext.globalNamespace)
     dynamicContext.inDefinition = true
-    val (ir, module) = Builder.build(Module(proto), dynamicContext, false)
+    dynamicContext.profiler = profiler
+    dynamicContext.binaryPrintf = parent.binaryPrintf
+    dynamicContext.instantiateCache = parent.instantiateCache
+    val (ir, module) = Builder.build(Module(proto), dynamicContext, false, checkpoint)
+    (ir, module, dynamicContext)
+  }
+
+  // Adds an elaborated Definition to the current context
+  private def adopt[T <: BaseModule with IsInstantiable](ir: Circuit, module: T): Definition[T] = {
     Builder.components ++= ir.components
     Builder.annotations ++= ir.annotations: @nowarn // this will go away when firrtl is merged
     module._circuit = Builder.currentModule
-    dynamicContext.globalNamespace.copyTo(Builder.globalNamespace)
     new Definition(Proto(module))
   }
 
@@ -0,0 +1,172 @@
+// SPDX-License-Identifier: Apache-2.0
+
+package chisel3.internal
+
+import chisel3._
+import chisel3.experimental.{BaseModule, ChiselAnnotation, IntParam, SourceInfo}
+import chisel3.internal.firrtl.{Circuit, DefBlackBox}
+import firrtl.transforms.BlackBoxInlineAnno
+
+import scala.annotation.nowarn
+import scala.collection.immutable.ListMap
+
+/** Lowers printfs to binary records, which are formatted after simulation instead of in the simulation's eval loop
+  *
+  * Each printf becomes a [[BinaryPrintf.Channel]], which calls DPI functions on each cycle it is enabled to append a
+  * record of the printf's id and the raw values of its arguments. The simulation must define these functions:
+  * {{{
+  *   // Begins a record of the printf with the given id, whose arguments are the following `words` words
+  *   extern "C" void chisel_binary_printf_begin(int id, int words);
+  *   extern "C" void chisel_binary_printf_word(int word);
+  * }}}
+  * svsim's simulation driver defines them, see `SVSIM_BINARY_PRINTF`. The printfs are given their ids by [[number]]
+  * at the end of elaboration, in the order of the modules of the circuit, so the ids do not depend on the order in
+  * which concurrently elaborated Definitions finish. The format of each printf is recorded in a [[BinaryPrintf.Table]],
+  * see [[chisel3.stage.BinaryPrintfAnnotation]].
+  */
+private[chisel3] object BinaryPrintf {
+
+  /** Each argument is zero extended to a whole number of words of this width */
+  val WordWidth = 32
+
+  /** The number of words an argument of the given width is recorded in */
+  def words(width: Int): Int = ((width + WordWidth - 1) / WordWidth).max(1)
+
+  /** The formats of the printfs of a circuit, indexed by their ids
+    *
+    * @param channels the channel of each printf, indexed by its id
+    */
+  class Table private[BinaryPrintf] (channels: Seq[Channel]) {
+
+    /** Serializes the table as JSON
+      *
+      * Each format is a list of parts, which are either `{"text": ...}`, or an argument
+      * `{"format": "d" | "x" | "b" | "c", "width": ..., "signed": ...}`.
+      */
+    def toJson: String = {
+      def parts(pable: Printable, module: BaseModule): Seq[ujson.Obj] = pable match {
+        case Printables(pables) => pables.toSeq.flatMap(parts(_, module))
+        case PString(str)       => Seq(ujson.Obj("text" -> str))
+        case Percent            => Seq(ujson.Obj("text" -> "%"))
+        case format: FirrtlFormat =>
+          Seq(
+            ujson.Obj(
+              "format" -> format.specifier.toString,
+              "width" -> format.bits.getWidth,
+              "signed" -> format.bits.isInstanceOf[SInt]
+            )
+          )
+        case name @ (_: Name | _: FullName) => Seq(ujson.Obj("text" -> name.unpack(module._component.get)._1))
+      }
+      val formats = channels.map { channel =>
+        ujson.Obj("parts" -> ujson.Arr(parts(channel.pable, channel.module): _*))
+      }
+      ujson.write(ujson.Obj("wordWidth" -> WordWidth, "formats" -> ujson.Arr(formats: _*)))
+    }
+  }
+
+  /** Gives each printf of an elaborated circuit its id, in the order of the circuit's modules, and returns the circuit
+    * with the ids set and the table of their formats
+    *
+    * Only the channels in the circuit are numbered, so printfs of Definitions which were elaborated but then discarded
+    * are not. The Verilog of the channels is added to the circuit once.
+    */
+  @nowarn("msg=Do not use annotations val of Circuit directly")
+  def number(circuit: Circuit): (Circuit, Table) = {
+    val channels = Seq.newBuilder[Channel]
+    var count = 0
+    val components = circuit.components.map {
+      case component @ DefBlackBox(channel: Channel, _, _, _, params) =>
+        channels += channel
+        count += 1
+        component.copy(params = params + ("ID" -> IntParam(count - 1)))
+      case component => component
+    }
+    val table = new Table(channels.result())
+    val verilog = components.collectFirst {
+      case DefBlackBox(channel: Channel, _, _, _, _) =>
+        new ChiselAnnotation {
+          def toFirrtl = BlackBoxInlineAnno(channel.toNamed, "BinaryPrintf.sv", BinaryPrintf.verilog)
+        }
+    }
+    (circuit.copy(components = components, annotations = circuit.annotations ++ verilog), table)
+  }
+
+  /** Calls the DPI functions which record a printf, on each rising edge of `clock` that `enable` is set, with `data`
+    * split into `words` words, least significant first
+    *
+    * Its `ID` parameter is set by [[number]].
+    *
+    * @param pable the format of the printf
+    * @param module the module which contains the printf
+    */
+  private[chisel3] class Channel(val pable: Printable, val module: BaseModule, words: Int)
+      extends BlackBox(Map("WORDS" -> IntParam(words))) {
+    // This is not compiled with the plugin, so the port must be named explicitly
+    val io = IO(new ChannelIO(words.max(1) * WordWidth)).suggestName("io")
+    override def desiredName = "BinaryPrintf"
+  }
+
+  private[chisel3] class ChannelIO(dataWidth: Int) extends Record {
+    val clock = Input(Clock())
+    val enable = Input(Bool())
+    val data = Input(UInt(dataWidth.W))
+    val elements = ListMap("clock" -> clock, "enable" -> enable, "data" -> data)
+    override def cloneType = (new ChannelIO(dataWidth)).asInstanceOf[this.type]
+  }
+
+  // Like the printfs emitted by firtool, records are only written if `PRINTF_COND` is set, when it is defined
+  private val verilog =
+    s"""module BinaryPrintf #(
+       |  parameter ID = 0,
+       |  parameter WORDS = 0
+       |) (
+       |  input clock,
+       |  input enable,
+       |  input [${WordWidth} * (WORDS == 0 ? 1 : WORDS) - 1:0] data
+       |);
+       |`ifndef SYNTHESIS
+       |  import "DPI-C" function void chisel_binary_printf_begin(input int id, input int words);
+       |  import "DPI-C" function void chisel_binary_printf_word(input int word);
+       |  always @(posedge clock) begin
+       |`ifdef PRINTF_COND
+       |    if (`PRINTF_COND && enable) begin
+       |`else
+       |    if (enable) begin
+       |`endif
+       |      chisel_binary_printf_begin(ID, WORDS);
+       |      for (int i = 0; i < WORDS; i = i + 1)
+       |        chisel_binary_printf_word(data[i * ${WordWidth} +: ${WordWidth}]);
+       |    end
+       |  end
+       |`endif
+       |endmodule
+       |""".stripMargin
+
+  /** Lowers a printf to a [[Channel]], enabled by the current `when` condition
+    *
+    * @throws java.lang.IllegalArgumentException if the width of an argument is not known
+    */
+  def apply(pable: Printable, clock: Clock)(implicit sourceInfo: SourceInfo): Unit = {
+    def formats(pable: Printable): Seq[FirrtlFormat] = pable match {
+      case Printables(pables)   => pables.toSeq.flatMap(formats)
+      case format: FirrtlFormat => Seq(format)
+      case _                    => Seq.empty
+    }
+    val arguments = formats(pable).map(_.bits)
+    arguments.foreach { bits =>
+      require(bits.isWidthKnown, s"The width of printf argument $bits must be known to print it as a binary record")
+    }
+    val words = arguments.map(bits => BinaryPrintf.words(bits.getWidth)).sum
+    // The first argument is in the least significant words
+    val data = arguments
+      .map(bits => bits.asUInt.pad(BinaryPrintf.words(bits.getWidth) * WordWidth))
+      .reduceLeftOption((low, high) => high ## low)
+      .getOrElse(0.U(WordWidth.W))
+
+    val channel = Module(new Channel(pable, Builder.forcedUserModule, words))
+    channel.io.clock := clock
+    channel.io.enable := when.cond
+    channel.io.data := data
+  }
+}
@@ -6,6 +6,7 @@ import scala.util.DynamicVariable
 import scala.collection.mutable.ArrayBuffer
 import chisel3._
 import chisel3.experimental._
+import chisel3.experimental.hierarchy.{InstantiateCache, InstantiateCacheAnnotation}
 import chisel3.experimental.hierarchy.core.{Clone, ImportDefinitionAnnotation, Instance}
 import chisel3.internal.firrtl._
 import chisel3.internal.naming._
@@ -23,29 +24,83 @@ import scala.annotation.tailrec
 import java.io.File
 
 private[chisel3] class Namespace(keywords: Set[String], separator: Char = '_') {
-  // This HashMap is compressed, not every name in the namespace is present here.
-  // If the same name is requested multiple times, it only takes 1 entry in the HashMap and the
-  // value is incremented for each time the name is requested.
+  // This table is compressed, not every name in the namespace is present here.
+  // If the same name is requested multiple times, it only takes 1 entry in the table and its
+  // index is incremented for each time the name is requested.
   // Names can be requested that collide with compressed sets of names, thus the algorithm for
-  // checking if a name is present in the Namespace is more complex than just checking the HashMap,
+  // checking if a name is present in the Namespace is more complex than just checking the table,
   // see getIndex below.
-  private val names = collection.mutable.HashMap[String, Long]()
-  def copyTo(other: Namespace): Unit = names.foreach { case (s: String, l: Long) => other.names(s) = l }
+  //
+  // The table is an open addressing hash table of names and their indices, so that indices are not boxed and
+  // prefixes can be looked up without extracting them from names, see slot. Indices are always at least 1, and empty
+  // slots have index 0.
+  private var names = new Array[String](Namespace.capacityFor(keywords.size))
+  private var indices = new Array[Long](names.length)
+  private var size = 0
+  // If set, every name requested from this Namespace (or from any Namespace it is copied to) is recorded here, see fork
+  private var journal: ArrayBuffer[(String, Boolean, String)] = null
+  def copyTo(other: Namespace): Unit = {
+    if (other.size == 0) {
+      other.names = names.clone()
+      other.indices = indices.clone()
+      other.size = size
+    } else {
+      for (i <- names.indices if names(i) != null) other.update(names(i), indices(i))
+    }
+    if (journal != null) other.journal = journal
+  }
   for (keyword <- keywords)
-    names(keyword) = 1
+    update(keyword, 1)
+
+  // The slot of the name equal to the first `length` characters of `n`, whose hash code is `hash`, or otherwise of
+  // the empty slot where it would be added
+  private def slot(n: String, length: Int, hash: Int): Int = {
+    val mask = names.length - 1
+    val mixed = hash * -0x61c88647 // the golden ratio, to spread the hash codes of similar names
+    var i = (mixed ^ (mixed >>> 16)) & mask
+    while (names(i) != null && !(names(i).length == length && n.regionMatches(0, names(i), 0, length))) {
+      i = (i + 1) & mask
+    }
+    i
+  }
+
+  private def slot(n: String): Int = slot(n, n.length, n.hashCode)
+
+  private def update(n: String, index: Long): Unit = {
+    val i = slot(n)
+    indices(i) = index
+    if (names(i) == null) {
+      names(i) = n
+      size += 1
+      // Keep the table at most half full, so that probe sequences stay short
+      if (size * 2 > names.length) grow()
+    }
+  }
+
+  private def grow(): Unit = {
+    val oldNames = names
+    val oldIndices = indices
+    names = new Array[String](oldNames.length * 2)
+    indices = new Array[Long](names.length)
+    for (i <- oldNames.indices if oldNames(i) != null) {
+      val j = slot(oldNames(i))
+      names(j) = oldNames(i)
+      indices(j) = oldIndices(i)
+    }
+  }
 
   @tailrec
   private def rename(n: String, index: Long): String = {
     val tryName = s"${n}${separator}${index}"
-    if (names.contains(tryName)) {
+    if (indices(slot(tryName)) != 0) {
       rename(n, index + 1)
     } else {
-      names(n) = index + 1
+      update(n, index + 1)
       tryName
     }
   }
 
-  /** Checks if `n` ends in `_\d+` and returns the substring before `_` if so, null otherwise */
+  /** Checks if `n` ends in `_\d+` and returns the index of the `_` if so, 0 otherwise */
   // TODO can and should this be folded in to sanitize? Same iteration as the forall?
   private def prefix(n: String): Int = {
     // This is micro-optimized because it runs on every single name
@@ -54,58 +109,109 @@ private[chisel3] class Namespace(keywords: Set[String], separator: Char = '_') {
       i -= 1
     }
     // Will get i == 0 for all digits or _\d+ with empty prefix, those have no prefix so returning 0 is correct
-    if (i == n.size) 0 // no digits
+    if (i == n.size - 1) 0 // no digits
     else if (n(i) != separator) 0 // no _
     else i
   }
 
-  // Gets the current index for this name, None means it is not contained in the Namespace
-  private def getIndex(elem: String): Option[Long] =
-    names.get(elem).orElse {
+  // Gets the current index for this name, 0 means it is not contained in the Namespace
+  private def getIndex(elem: String): Long = {
+    val index = indices(slot(elem))
+    if (index != 0) index
+    else {
       // This exact name isn't contained, but if we end in _<idx>, we need to check our prefix
       val maybePrefix = prefix(elem)
-      if (maybePrefix == 0) None
+      if (maybePrefix == 0) 0
       else {
+        var prefixHash = 0
+        for (i <- 0 until maybePrefix) prefixHash = 31 * prefixHash + elem(i) // String.hashCode of the prefix
+        val prefixIdx = indices(slot(elem, maybePrefix, prefixHash))
+        // Our index only matters if it is below the prefix's, so stop parsing it (before it could overflow) otherwise
+        var ourIdx = 0L
+        var i = maybePrefix + 1
+        while (i < elem.length && ourIdx < prefixIdx) {
+          ourIdx = ourIdx * 10 + (elem(i) - '0')
+          i += 1
+        }
         // If we get a prefix collision and our index is taken, we start disambiguating with _<idx>_1
-        names
-          .get(elem.take(maybePrefix))
-          .filter { prefixIdx =>
-            val ourIdx = elem.drop(maybePrefix + 1).toInt
-            // The namespace starts disambiguating at _1 so _0 is a false collision case
-            ourIdx != 0 && prefixIdx > ourIdx
-          }
-          .map(_ => 1)
+        // The namespace starts disambiguating at _1 so _0 is a false collision case
+        if (ourIdx != 0 && prefixIdx > ourIdx) 1 else 0
       }
     }
+  }
 
-  def contains(elem: String): Boolean = getIndex(elem).isDefined
+  def contains(elem: String): Boolean = getIndex(elem) != 0
 
   // leadingDigitOk is for use in fields of Records
   def name(elem: String, leadingDigitOk: Boolean = false): String = {
     val sanitized = sanitize(elem, leadingDigitOk)
-    getIndex(sanitized) match {
-      case Some(idx) => rename(sanitized, idx)
-      case None =>
-        names(sanitized) = 1
+    val idx = getIndex(sanitized)
+    val result =
+      if (idx != 0) rename(sanitized, idx)
+      else {
+        update(sanitized, 1)
         sanitized
-    }
+      }
+    if (journal != null) journal += ((elem, leadingDigitOk, result))
+    result
+  }
+
+  /** Returns a copy of this Namespace which records every name requested from it
+    *
+    * Requesting the recorded names from another Namespace in the same order (see [[accepts]] and [[replay]]) checks
+    * whether they would have been the same had they been requested from it instead.
+    */
+  def fork(): Namespace = {
+    val forked = new Namespace(Set.empty[String], separator)
+    copyTo(forked)
+    forked.journal = ArrayBuffer.empty
+    forked
   }
+
+  /** The names requested from this Namespace since it was forked */
+  def requested: Seq[(String, Boolean, String)] = journal.toSeq
+
+  /** Checks whether requesting the names in `record` from this Namespace, in order, would produce the same names,
+    * without requesting them
+    */
+  def accepts(record: Seq[(String, Boolean, String)]): Boolean = {
+    val scratch = new Namespace(Set.empty[String], separator)
+    scratch.names = names.clone()
+    scratch.indices = indices.clone()
+    scratch.size = size
+    record.forall { case (elem, leadingDigitOk, result) => scratch.name(elem, leadingDigitOk) == result }
+  }
+
+  /** Requests the names in `record` from this Namespace, in order, see [[accepts]] */
+  def replay(record: Seq[(String, Boolean, String)]): Unit =
+    record.foreach { case (elem, leadingDigitOk, _) => name(elem, leadingDigitOk) }
 }
 
 private[chisel3] object Namespace {
 
+  /** The initial table capacity of a Namespace of `size` names, a power of two at least twice `size` */
+  private def capacityFor(size: Int): Int = Integer.highestOneBit((size * 2).max(16) - 1) << 1
+
   /** Constructs an empty Namespace */
   def empty(separator: Char): Namespace = new Namespace(Set.empty[String], separator)
   def empty: Namespace = new Namespace(Set.empty[String])
 }
 
-private[chisel3] class IdGen {
-  private var counter = -1L
+private[chisel3] class IdGen(first: Long = 0L) {
+  private var counter = first - 1
+  private var _allocated = 0L
   def next: Long = {
     counter += 1
+    _allocated += 1
     counter
   }
   def value: Long = counter
+
+  /** The number of ids this has generated, which unlike `value` is not affected by `advancePast` */
+  def allocated: Long = _allocated
+
+  /** Skips ahead so that the next id is greater than `value` */
+  def advancePast(value: Long): Unit = counter = counter.max(value)
 }
 
 private[chisel3] trait HasId extends chisel3.InstanceId {
@@ -401,23 +507,25 @@ private[chisel3] trait NamedComponent extends HasId {
 }
 
 // Mutable global state for chisel that can appear outside a Builder context
-private[chisel3] class ChiselContext() {
-  val idGen = new IdGen
-
-  // Records the different prefixes which have been scoped at this point in time
-  var prefixStack: Prefix = Nil
-
+private[chisel3] class ChiselContext(
+  val idGen: IdGen,
   // Views belong to a separate namespace (for renaming)
   // The namespace outside of Builder context is useless, but it ensures that views can still be created
   // and the resulting .toTarget is very clearly useless (_$$View$$_...)
-  val viewNamespace = Namespace.empty
+  val viewNamespace: Namespace) {
+  def this() = this(new IdGen, Namespace.empty)
+
+  // Records the different prefixes which have been scoped at this point in time
+  var prefixStack: Prefix = Nil
 }
 
 private[chisel3] class DynamicContext(
   val annotationSeq:     AnnotationSeq,
   val throwOnFirstError: Boolean,
   val warningsAsErrors:  Boolean,
-  val sourceRoots:       Seq[File]) {
+  val sourceRoots:       Seq[File],
+  // The number of threads on which Definitions may be elaborated concurrently, see Definition.concurrently
+  val definitionThreads: Int) {
   val importedDefinitionAnnos = annotationSeq.collect { case a: ImportDefinitionAnnotation[_] => a }
 
   // Map from proto module name to ext-module name
@@ -486,6 +594,23 @@ private[chisel3] class DynamicContext(
 
   // Used to indicate if this is the top-level module of full elaboration, or from a Definition
   var inDefinition: Boolean = false
+
+  // The threads on which Definitions are elaborated concurrently, shared by the whole elaboration
+  var definitionThreadPool: DefinitionThreads = new DefinitionThreads(definitionThreads)
+
+  // Set to profile the elaboration of each module
+  var profiler: Option[ElaborationProfiler] = None
+
+  // Set to lower printfs to binary records, see BinaryPrintf
+  var binaryPrintf: Boolean = false
+
+  // Set to keep the Definitions built by Instantiate across elaborations
+  var instantiateCache: Option[InstantiateCache] = annotationSeq.collectFirst {
+    case InstantiateCacheAnnotation(cache) => cache
+  }
+
+  // Whether the types of pairs of Aggregates are equivalent, keyed by their typePrototypes, see Data.typeEquivalent
+  val typeEquivalence = mutable.HashMap.empty[(Aggregate, Aggregate), Boolean]
 }
 
 private[chisel3] object Builder extends LazyLogging {
@@ -515,6 +640,17 @@ private[chisel3] object Builder extends LazyLogging {
     }
   }
 
+  // Runs f with context as the ChiselContext of this thread
+  private[chisel3] def withChiselContext[T](context: ChiselContext)(f: => T): T = {
+    val previous = chiselContext.get()
+    chiselContext.set(context)
+    try {
+      f
+    } finally {
+      chiselContext.set(previous)
+    }
+  }
+
   // Initialize any singleton objects before user code inadvertently inherits them.
   private def initializeSingletons(): Unit = {
     // This used to contain:
@@ -538,6 +674,14 @@ private[chisel3] object Builder extends LazyLogging {
 
   def contextCache: BuilderContextCache = dynamicContext.contextCache
 
+  def profiler: Option[ElaborationProfiler] = dynamicContext.profiler
+
+  def binaryPrintf: Boolean = dynamicContext.binaryPrintf
+
+  def instantiateCache: Option[InstantiateCache] = dynamicContext.instantiateCache
+
+  def typeEquivalence: mutable.Map[(Aggregate, Aggregate), Boolean] = dynamicContext.typeEquivalence
+
   // TODO : Unify this with annotations in the future - done this way for backward compatability
   def newAnnotations: ArrayBuffer[ChiselMultiAnnotation] = dynamicContext.newAnnotations
 
@@ -818,25 +962,41 @@ private[chisel3] object Builder extends LazyLogging {
     renames
   }
 
+  /** @param checkpoint whether to report errors and warnings when done, otherwise [[checkpoint]] must be called to
+    * report them
+    */
   private[chisel3] def build[T <: BaseModule](
     f:              => T,
     dynamicContext: DynamicContext,
-    forceModName:   Boolean = true
+    forceModName:   Boolean = true,
+    checkpoint:     Boolean = true
   ): (Circuit, T) = {
     dynamicContextVar.withValue(Some(dynamicContext)) {
       ViewParent: Unit // Must initialize the singleton in a Builder context or weird things can happen
       // in tiny designs/testcases that never access anything in chisel3.internal
-      logger.info("Elaborating design...")
-      val mod = f
-      if (forceModName) { // This avoids definition name index skipping with D/I
-        mod.forceName(mod.name, globalNamespace)
-      }
-      errors.checkpoint(logger)
-      logger.info("Done elaborating.")
+      try {
+        logger.info("Elaborating design...")
+        val mod = f
+        if (forceModName) { // This avoids definition name index skipping with D/I
+          mod.forceName(mod.name, globalNamespace)
+        }
+        if (checkpoint) {
+          errors.checkpoint(logger)
+        }
+        logger.info("Done elaborating.")
 
-      (Circuit(components.last.name, components.toSeq, annotations.toSeq, makeViewRenameMap, newAnnotations.toSeq), mod)
+        (Circuit(components.last.name, components.toSeq, annotations.toSeq, makeViewRenameMap, newAnnotations.toSeq), mod)
+      } finally {
+        // Definitions share the threads of the elaboration which contains them
+        if (!dynamicContext.inDefinition) {
+          dynamicContext.definitionThreadPool.shutdown()
+        }
+      }
     }
   }
+
+  // Reports the errors and warnings of a build of dynamicContext which did not, see build
+  private[chisel3] def checkpoint(dynamicContext: DynamicContext): Unit = dynamicContext.errors.checkpoint(logger)
   initializeSingletons()
 }
 
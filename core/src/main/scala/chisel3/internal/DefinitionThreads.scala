@@ -0,0 +1,45 @@
+// SPDX-License-Identifier: Apache-2.0
+
+package chisel3.internal
+
+import java.util.concurrent.{Callable, ExecutorService, Executors, Future, ThreadFactory}
+
+/** The threads on which the Definitions of one elaboration are elaborated concurrently, see
+  * [[chisel3.experimental.hierarchy.core.Definition.concurrently]].
+  *
+  * The threads are started when they are first needed, are shared by every Definition of the elaboration, and are
+  * stopped by [[shutdown]] when the elaboration ends.
+  *
+  * @param count the number of threads
+  */
+private[chisel3] class DefinitionThreads(val count: Int) {
+  private class Worker(runnable: Runnable) extends Thread(runnable, "chisel-definition") {
+    setDaemon(true)
+  }
+
+  private var pool: Option[ExecutorService] = None
+
+  /** Whether Definitions may be elaborated on these threads from the current thread.
+    *
+    * Definitions elaborated on these threads build their own Definitions serially, since waiting on the threads
+    * from one of them could leave every thread waiting and would oversubscribe the machine.
+    */
+  def available: Boolean = count > 1 && !Thread.currentThread().isInstanceOf[Worker]
+
+  def submit[T](task: () => T): Future[T] = {
+    val executor = synchronized {
+      if (pool.isEmpty) {
+        pool = Some(Executors.newFixedThreadPool(count, new ThreadFactory {
+          def newThread(runnable: Runnable): Thread = new Worker(runnable)
+        }))
+      }
+      pool.get
+    }
+    executor.submit(new Callable[T] { def call() = task() })
+  }
+
+  def shutdown(): Unit = synchronized {
+    pool.foreach(_.shutdownNow())
+    pool = None
+  }
+}
@@ -0,0 +1,217 @@
+// SPDX-License-Identifier: Apache-2.0
+
+package chisel3.internal
+
+import chisel3.experimental.BaseModule
+import chisel3.internal.firrtl.{Component, DefModule}
+
+import java.lang.management.ManagementFactory
+import scala.annotation.nowarn
+import scala.collection.mutable.ArrayBuffer
+
+private[chisel3] object ElaborationProfiler {
+
+  /** The elaboration of one module
+    *
+    * Everything except `inclusiveNanos` excludes the elaboration of the module's submodules.
+    *
+    * @param className the class of the module
+    * @param desiredName the desired name of the module, which usually reflects its parameterization
+    * @param name the name of the module
+    * @param thread the thread which elaborated the module
+    * @param startNanos when elaboration of the module started, relative to when profiling started
+    * @param inclusiveNanos the wall time spent elaborating the module, including its submodules
+    * @param exclusiveNanos the wall time spent elaborating the module
+    * @param allocatedBytes the bytes allocated while elaborating the module, if the JVM can measure them
+    * @param commands the number of commands in the module
+    * @param ids the number of objects with ids (data, memories, modules, ...) created while elaborating the module
+    */
+  case class Sample(
+    className:      String,
+    desiredName:    String,
+    name:           String,
+    thread:         Long,
+    startNanos:     Long,
+    inclusiveNanos: Long,
+    exclusiveNanos: Long,
+    allocatedBytes: Long,
+    commands:       Int,
+    ids:            Long)
+
+  private val threadMXBean = ManagementFactory.getThreadMXBean() match {
+    case bean: com.sun.management.ThreadMXBean if bean.isThreadAllocatedMemorySupported() =>
+      if (!bean.isThreadAllocatedMemoryEnabled()) {
+        bean.setThreadAllocatedMemoryEnabled(true)
+      }
+      Some(bean)
+    case _ => None
+  }
+
+  @nowarn("cat=deprecation") // Thread.threadId(), its replacement, is not available before Java 19
+  private def currentThread: Long = Thread.currentThread().getId()
+
+  // The bytes allocated by the current thread so far, or 0 if this cannot be measured
+  private def allocatedBytes(): Long = threadMXBean.map(_.getThreadAllocatedBytes(currentThread)).getOrElse(0L)
+}
+
+/** Records the wall time, allocated bytes, commands and ids of the elaboration of every module, see
+  * [[chisel3.Module.do_apply]]
+  *
+  * Modules may be elaborated speculatively on other threads, see
+  * [[chisel3.experimental.hierarchy.core.Definition.concurrently]]. Each speculation is recorded by a [[fork]] of
+  * this profiler, which is [[adopt]]ed if the speculation is kept, and the time the module in progress spends waiting
+  * for speculations is excluded from it with [[waitingFor]].
+  */
+private[chisel3] class ElaborationProfiler private (origin: Long) {
+  import ElaborationProfiler._
+
+  def this() = this(System.nanoTime())
+
+  private val _samples = ArrayBuffer.empty[Sample]
+
+  // The elaborations in progress on each thread, innermost first
+  private val inProgress = new ThreadLocal[List[Elaboration]] {
+    override def initialValue = Nil
+  }
+
+  /** The elaboration of a module which is in progress */
+  class Elaboration private[ElaborationProfiler] () {
+    private val startNanos = System.nanoTime()
+    private val startBytes = allocatedBytes()
+    // Ids are counted in the context of the module, since speculations generate ids far ahead of their parents
+    private val idGen = Builder.idGen
+    private val startIds = idGen.allocated
+    // Totals of submodules, which are excluded from this module
+    private[ElaborationProfiler] var submoduleNanos = 0L
+    private var submoduleBytes = 0L
+    private var submoduleIds = 0L
+
+    /** Records the elaboration of `module`, which generated `component`, as finished */
+    def finish(module: BaseModule, component: Option[Component]): Unit = {
+      val nanos = System.nanoTime() - startNanos
+      val bytes = allocatedBytes() - startBytes
+      val ids = idGen.allocated - startIds
+      // Elaborations which threw are never finished, so skip past any of them
+      inProgress.set(inProgress.get.dropWhile(_ ne this).drop(1))
+      inProgress.get.headOption.foreach { parent =>
+        parent.submoduleNanos += nanos
+        parent.submoduleBytes += bytes
+        parent.submoduleIds += ids
+      }
+      for (component <- component) {
+        val commands = component match {
+          case ctx: DefModule => ctx.commands.size
+          case _ => 0
+        }
+        val sample = Sample(
+          module.getClass.getName,
+          module.desiredName,
+          component.name,
+          currentThread,
+          startNanos - origin,
+          nanos,
+          nanos - submoduleNanos,
+          bytes - submoduleBytes,
+          commands,
+          ids - submoduleIds
+        )
+        _samples.synchronized { _samples += sample }
+      }
+    }
+  }
+
+  /** Runs `f`, which waits for modules being elaborated on other threads, excluding the time it takes from the
+    * module being elaborated on the current thread
+    */
+  def waitingFor[T](f: => T): T = {
+    val startNanos = System.nanoTime()
+    try {
+      f
+    } finally {
+      inProgress.get.headOption.foreach(_.submoduleNanos += System.nanoTime() - startNanos)
+    }
+  }
+
+  /** Returns a profiler for a speculative elaboration, whose samples are only kept if it is [[adopt]]ed */
+  def fork(): ElaborationProfiler = new ElaborationProfiler(origin)
+
+  /** Keeps the samples of `fork`, whose speculative elaboration was kept */
+  def adopt(fork: ElaborationProfiler): Unit = {
+    val samples = fork.samples
+    _samples.synchronized { _samples ++= samples }
+  }
+
+  /** Records the start of the elaboration of a module on the current thread */
+  def start(): Elaboration = {
+    val elaboration = new Elaboration
+    inProgress.set(elaboration :: inProgress.get)
+    elaboration
+  }
+
+  /** The elaborations of every module so far, in the order in which they finished */
+  def samples: Seq[Sample] = _samples.synchronized { _samples.toList }
+
+  /** Returns a tab-separated report of the elaboration of each module class and desired name, with a header row,
+    * sorted by the wall time spent elaborating them (excluding their submodules), most first
+    */
+  def report: String = {
+    val header = Seq(
+      "class",
+      "desired_name",
+      "modules",
+      "inclusive_ns",
+      "exclusive_ns",
+      "allocated_bytes",
+      "commands",
+      "ids"
+    )
+    val rows = samples
+      .groupBy(sample => (sample.className, sample.desiredName))
+      .toSeq
+      .map {
+        case ((className, desiredName), group) =>
+          val exclusiveNanos = group.map(_.exclusiveNanos).sum
+          (
+            exclusiveNanos,
+            Seq(
+              className,
+              desiredName,
+              group.size,
+              group.map(_.inclusiveNanos).sum,
+              exclusiveNanos,
+              group.map(_.allocatedBytes).sum,
+              group.map(_.commands).sum,
+              group.map(_.ids).sum
+            )
+          )
+      }
+      .sortBy { case (exclusiveNanos, row) => (-exclusiveNanos, row.mkString("\t")) }
+      .map(_._2)
+    (header +: rows).map(_.mkString("\t")).mkString("", "\n", "\n")
+  }
+
+  /** Returns the elaboration of each module as a complete event in the Trace Event Format, which can be viewed with
+    * tools such as `chrome://tracing` or Perfetto
+    */
+  def traceEvents: String = {
+    val events = samples.sortBy(_.startNanos).map { sample =>
+      ujson.Obj(
+        "name" -> sample.name,
+        "cat" -> sample.className,
+        "ph" -> "X",
+        "ts" -> sample.startNanos / 1000.0,
+        "dur" -> sample.inclusiveNanos / 1000.0,
+        "pid" -> 0,
+        "tid" -> sample.thread.toDouble,
+        "args" -> ujson.Obj(
+          "desiredName" -> sample.desiredName,
+          "exclusiveNanos" -> sample.exclusiveNanos.toDouble,
+          "allocatedBytes" -> sample.allocatedBytes.toDouble,
+          "commands" -> sample.commands,
+          "ids" -> sample.ids.toDouble
+        )
+      )
+    }
+    ujson.write(ujson.Obj("traceEvents" -> ujson.Arr(events: _*), "displayTimeUnit" -> "ms"))
+  }
+}
@@ -10,7 +10,6 @@ import chisel3.internal.{castToInt, throwException, HasId}
 import chisel3.EnumType
 import scala.annotation.{nowarn, tailrec}
 import scala.collection.immutable.{Queue, VectorBuilder}
-import scala.collection.immutable.LazyList // Needed for 2.12 alias
 
 @nowarn("msg=class Port") // delete when Port becomes private
 private[chisel3] object Converter {
@@ -426,9 +425,34 @@ private[chisel3] object Converter {
   def convert(circuit: Circuit): fir.Circuit =
     fir.Circuit(fir.NoInfo, circuit.components.map(convert), circuit.name)
 
-  // TODO Unclear if this should just be the default
-  def convertLazily(circuit: Circuit): fir.Circuit = {
-    val lazyModules = LazyList() ++ circuit.components
-    fir.Circuit(fir.NoInfo, lazyModules.map(convert), circuit.name)
+  /** Converts `circuit` one module at a time, as its modules are accessed.
+    *
+    * Each module is converted at most once, when it is first accessed, and is retained from then on. Serializing the
+    * circuit with [[Serializer.lazily]] does not access its modules at all, since they are serialized directly from
+    * the Chisel IR (see [[lazilyConvertedComponents]]), so no converted module is held on the heap.
+    */
+  def convertLazily(circuit: Circuit): fir.Circuit =
+    fir.Circuit(fir.NoInfo, new LazilyConvertedModules(circuit.components), circuit.name)
+
+  /** The Chisel IR components from which the modules of `circuit` are lazily converted, if it was produced by
+    * [[convertLazily]].
+    */
+  def lazilyConvertedComponents(circuit: fir.Circuit): Option[Seq[Component]] = circuit.modules match {
+    case modules: LazilyConvertedModules => Some(modules.components)
+    case _ => None
+  }
+
+  private class LazilyConvertedModules(val components: Seq[Component])
+      extends scala.collection.immutable.Seq[fir.DefModule] {
+    private lazy val indexed = components.toIndexedSeq
+    private lazy val converted = new Array[fir.DefModule](indexed.length)
+    def apply(index: Int): fir.DefModule = synchronized {
+      if (converted(index) == null) {
+        converted(index) = convert(indexed(index))
+      }
+      converted(index)
+    }
+    def length: Int = indexed.length
+    def iterator: Iterator[fir.DefModule] = Iterator.range(0, length).map(apply)
   }
 }
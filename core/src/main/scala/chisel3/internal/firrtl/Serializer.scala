@@ -0,0 +1,272 @@
+// SPDX-License-Identifier: Apache-2.0
+
+package chisel3.internal.firrtl
+
+import chisel3.experimental.{NoSourceInfo, SourceInfo, SourceLine}
+import chisel3.internal.castToInt
+import firrtl.annotations.Annotation
+import firrtl.{ir => fir}
+
+import scala.annotation.nowarn
+
+/** Serializes Chisel IR directly to FIRRTL text, producing exactly the same text as converting it with [[Converter]]
+  * and serializing the result with `firrtl.ir.Serializer`, but without building a FIRRTL IR tree for each module.
+  *
+  * The commands which make up the bulk of most modules (nodes, connections, wires, registers, instances and when
+  * scopes) and their expressions are written directly. Types, ports and rarer commands are converted individually and
+  * serialized with `firrtl.ir.Serializer`, so only small, short-lived FIRRTL IR nodes are ever allocated.
+  */
+@nowarn("msg=class Port") // delete when Port becomes private
+private[chisel3] object Serializer {
+  private val Indent = fir.Serializer.Indent
+  private val NewLine = fir.Serializer.NewLine
+
+  /** Serializes `circuit` with `annotations`, producing the same text as
+    * `firrtl.ir.Serializer.lazily(CircuitWithAnnos(circuit, annotations))`. If the modules of `circuit` were converted
+    * by [[Converter.convertLazily]], they are serialized directly from the Chisel IR.
+    */
+  def lazily(circuit: fir.Circuit, annotations: Seq[Annotation]): Iterable[String] =
+    Converter.lazilyConvertedComponents(circuit) match {
+      case None => fir.Serializer.lazily(fir.CircuitWithAnnos(circuit, annotations))
+      case Some(components) =>
+        new Iterable[String] {
+          def iterator = {
+            // Serializing a circuit without modules produces its prelude, followed by a newline
+            val prelude = fir.Serializer.lazily(fir.CircuitWithAnnos(circuit.copy(modules = Nil), annotations))
+            val modules = components.iterator.zipWithIndex.flatMap {
+              case (component, index) =>
+                (if (index == 0) Iterator.empty else Iterator(s"$NewLine$NewLine")) ++ lazily(component)
+            }
+            prelude.iterator ++ modules ++ (if (components.isEmpty) Iterator.empty else Iterator(s"$NewLine"))
+          }
+        }.view
+    }
+
+  /** Serializes `component`, producing the same text as `firrtl.ir.Serializer.lazily(Converter.convert(component), 1)`.
+    */
+  def lazily(component: Component): Iterable[String] = new Iterable[String] {
+    def iterator = component match {
+      case ctx: DefModule =>
+        val header = {
+          val b = new StringBuilder
+          b ++= Indent; b ++= "module "; b ++= ctx.name; b ++= " :"
+          (ctx.ports ++ ctx.secretPorts).foreach { port =>
+            b += NewLine; b ++= Indent * 2; b ++= fir.Serializer.serialize(Converter.convert(port))
+          }
+          b += NewLine; b += NewLine
+          b.toString
+        }
+        Iterator(header) ++ new CommandSerializer(ctx)
+      case other => fir.Serializer.lazily(Converter.convert(other), 1).iterator
+    }
+  }.view
+
+  /** Serializes the commands of a module in chunks, tracking `when` scopes the same way as [[Converter.convert]].
+    *
+    * Lines are separated exactly as `firrtl.ir.Serializer` separates flattened statements: each line is followed by a
+    * newline if anything (including the end of a `when` scope) follows it, and a scope which contains no statements
+    * is serialized as `skip`.
+    */
+  private class CommandSerializer(ctx: DefModule) extends Iterator[String] {
+    private def bufferSize = 2048
+
+    /** @param alt whether the scope is the alternate (`else`) of its `when`
+      */
+    private case class Frame(alt: Boolean)
+
+    private val b = new StringBuilder
+    // Statements of the module body are indented twice, once for the module and once for the body
+    private var indent = 2
+
+    private val cmdsIt = (ctx.commands ++ ctx.secretCommands).iterator.buffered
+    // A command to process before the next command from `cmdsIt`, used to close nested scopes one at a time
+    private var nextCmd: Command = null
+    private var scope: List[Frame] = Nil
+    private var scopeIsEmpty = true
+    private var pendingNewLine = false
+    private var finished = false
+
+    def hasNext: Boolean = !finished
+
+    def next(): String = {
+      b.clear()
+      while (!finished && b.size < bufferSize) {
+        if (nextCmd != null || cmdsIt.hasNext) {
+          val cmd = if (nextCmd != null) {
+            val _nextCmd = nextCmd
+            nextCmd = null
+            _nextCmd
+          } else {
+            cmdsIt.next()
+          }
+          serialize(cmd)
+        } else {
+          assert(scope.isEmpty)
+          closeScope()
+          finished = true
+        }
+      }
+      b.toString
+    }
+
+    /** Starts a new line for a statement in the current scope.
+      *
+      * @param indented whether to indent the line, which is not needed if the statement is serialized with its indent
+      */
+    private def statement(indented: Boolean = true): Unit = {
+      endItem()
+      if (indented) {
+        (0 until indent).foreach { _ => b ++= Indent }
+      }
+      pendingNewLine = true
+      scopeIsEmpty = false
+    }
+
+    /** Terminates the previous line, since something follows it. */
+    private def endItem(): Unit = {
+      if (pendingNewLine) {
+        b += NewLine
+        pendingNewLine = false
+      }
+    }
+
+    private def closeScope(): Unit = {
+      if (scopeIsEmpty) {
+        statement(); b ++= "skip"
+      }
+    }
+
+    private def endWhen(): Unit = {
+      endItem()
+      indent -= 1
+      scope = scope.tail
+      // The `when` itself is a statement of the enclosing scope
+      scopeIsEmpty = false
+    }
+
+    private def serialize(cmd: Command): Unit = cmd match {
+      case e: DefPrim[_] =>
+        val consts = e.args.collect { case ILit(i) => i }
+        val args = e.args.filter {
+          case _: ILit => false
+          case _ => true
+        }
+        statement(); b ++= "node "; b ++= e.name; b ++= " = "
+        e.op.name match {
+          case "mux" =>
+            assert(args.size == 3, s"Mux with unexpected args: $args")
+            b ++= "mux("; s(args(0), e.sourceInfo); b ++= ", "; s(args(1), e.sourceInfo); b ++= ", "
+            s(args(2), e.sourceInfo); b += ')'
+          case op =>
+            b ++= op; b += '('
+            args.zipWithIndex.foreach {
+              case (arg, index) =>
+                s(arg, e.sourceInfo)
+                if (consts.nonEmpty || index < args.size - 1) b ++= ", "
+            }
+            b ++= consts.mkString(", "); b += ')'
+        }
+        s(e.sourceInfo)
+      case Connect(info, loc, exp) =>
+        statement(); s(loc, info); b ++= " <= "; s(exp, info); s(info)
+      case DefInvalid(info, arg) =>
+        statement(); s(arg, info); b ++= " is invalid"; s(info)
+      case e @ DefWire(info, id) =>
+        statement(); b ++= "wire "; b ++= e.name; b ++= " : "; s(Converter.extractType(id, info)); s(info)
+      case e @ DefReg(info, id, clock) =>
+        statement(); b ++= "reg "; b ++= e.name; b ++= " : "; s(Converter.extractType(id, info)); b ++= ", "
+        s(clock, info); s(info)
+      case e @ DefRegInit(info, id, clock, reset, init) =>
+        statement(); b ++= "reg "; b ++= e.name; b ++= " : "; s(Converter.extractType(id, info)); b ++= ", "
+        s(clock, info); b ++= " with :"; b += NewLine; (0 to indent).foreach { _ => b ++= Indent }
+        b ++= "reset => ("; s(reset, info); b ++= ", "; s(init, info); b += ')'; s(info)
+      case e @ DefInstance(info, id, _) =>
+        statement(); b ++= "inst "; b ++= e.name; b ++= " of "; b ++= id.name; s(info)
+      case WhenBegin(info, pred) =>
+        statement(); b ++= "when "; s(pred, info); b ++= " :"; s(info)
+        scope = Frame(alt = false) :: scope
+        scopeIsEmpty = true
+        indent += 1
+      case WhenEnd(info, depth, _) =>
+        val frame = scope.head
+        closeScope()
+        // Check if this when has an else
+        cmdsIt.headOption match {
+          case Some(AltBegin(_)) =>
+            assert(!frame.alt, "Internal Error! Unexpected when structure!") // Only 1 else per when
+            cmdsIt.next() // Consume the AltBegin
+            indent -= 1; statement(); b ++= "else :"; indent += 1
+            scope = frame.copy(alt = true) :: scope.tail
+            scopeIsEmpty = true
+          case _ => // Not followed by otherwise
+            // If depth > 0 then we need to close multiple When scopes
+            if (depth > 0) {
+              nextCmd = WhenEnd(info, depth - 1, false)
+            }
+            endWhen()
+        }
+      case OtherwiseEnd(info, depth) =>
+        closeScope()
+        // depth == 1 indicates the last closing otherwise, see Converter.convert
+        if (depth > 1) {
+          nextCmd = OtherwiseEnd(info, depth - 1)
+        }
+        endWhen()
+      case other =>
+        Converter.convertSimpleCommand(other, ctx) match {
+          case Some(stmt) =>
+            statement(indented = false); b ++= fir.Serializer.serialize(stmt, indent)
+          case None =>
+            throw new MatchError(other)
+        }
+    }
+
+    /** Serializes an expression, as `firrtl.ir.Serializer` would serialize `Converter.convert(arg, ctx, info)`. */
+    private def s(arg: Arg, info: SourceInfo): Unit = arg match {
+      case Node(id) =>
+        s(Converter.getRef(id, info), info)
+      case Ref(name) =>
+        b ++= name
+      case Slot(imm, name) =>
+        s(imm, info); b += '.'; b ++= name
+      case OpaqueSlot(imm) =>
+        s(imm, info)
+      case Index(imm, ILit(idx)) =>
+        s(imm, info); b += '['; b ++= castToInt(idx, "Index").toString; b += ']'
+      case Index(imm, value) =>
+        s(imm, info); b += '['; s(value, info); b += ']'
+      case ModuleIO(mod, name) =>
+        if (mod eq ctx.id) b ++= name
+        else { b ++= Converter.getRef(mod, info).name; b += '.'; b ++= name }
+      case ModuleCloneIO(mod, name) if !(mod eq ctx.id) =>
+        b ++= name
+      case u @ ULit(n, UnknownWidth()) =>
+        uint(n, u.minWidth)
+      case ULit(n, KnownWidth(width)) =>
+        uint(n, width)
+      case slit @ SLit(n, _) =>
+        val unsigned = if (n < 0) (BigInt(1) << slit.width.get) + n else n
+        b ++= "asSInt("; uint(unsigned, slit.width.get); b += ')'
+      case ProbeExpr(probe) =>
+        b ++= "probe("; s(probe, info); b += ')'
+      case RWProbeExpr(probe) =>
+        b ++= "rwprobe("; s(probe, info); b += ')'
+      case ProbeRead(probe) =>
+        b ++= "read("; s(probe, info); b += ')'
+      // Errors and anything unexpected are handled by the Converter
+      case other =>
+        b ++= fir.Serializer.serialize(Converter.convert(other, ctx, info))
+    }
+
+    private def uint(value: BigInt, width: Int): Unit = {
+      b ++= "UInt<"; b ++= width.toString; b ++= ">(\"h"; b ++= value.toString(16); b ++= "\")"
+    }
+
+    private def s(tpe: fir.Type): Unit = b ++= fir.Serializer.serialize(tpe)
+
+    private def s(info: SourceInfo): Unit = info match {
+      case _: NoSourceInfo => // empty string
+      case SourceLine(fn, line, col) => b ++= " @["; b ++= fir.FileInfo.escape(s"$fn $line:$col"); b += ']'
+    }
+  }
+}
@@ -135,6 +135,9 @@ package object internal {
   }
 
   private[chisel3] def containsProbe(data: Data): Boolean = data match {
+    // Every element of a Vec has the type of its sample_element, plus any probe modifier of the Vec itself
+    case v: Vec[_] =>
+      v.length > 0 && (v.probeInfo.nonEmpty || containsProbe(v.sample_element))
     case a: Aggregate =>
       a.elementsIterator.foldLeft(false)((res: Boolean, d: Data) => res || containsProbe(d))
     case leaf => leaf.probeInfo.nonEmpty
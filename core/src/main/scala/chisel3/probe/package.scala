@@ -18,6 +18,8 @@ package object probe extends SourceInfoDoc {
     probeInfo.foreach { _ =>
       data.probeInfo = probeInfo
       data match {
+        case v: Vec[_] =>
+          v.foreachElement { e => setProbeModifier(e, probeInfo) }
         case a: Aggregate =>
           a.elementsIterator.foreach { e => setProbeModifier(e, probeInfo) }
         case _ => // do nothing
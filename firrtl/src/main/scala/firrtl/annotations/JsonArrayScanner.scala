@@ -0,0 +1,144 @@
+// SPDX-License-Identifier: Apache-2.0
+
+package firrtl.annotations
+
+import java.io.Reader
+
+/** Scans a JSON array one element at a time, without building a JSON AST for the whole array.
+  *
+  * This does not validate the JSON that it scans beyond finding where each element ends, it is up to the consumer of
+  * the elements to parse them.
+  *
+  * @param reader the JSON, should be buffered
+  */
+private[annotations] class JsonArrayScanner(reader: Reader) {
+  import JsonArrayScanner.MalformedJsonException
+
+  private var c: Int = reader.read()
+
+  private def next(): Unit = c = reader.read()
+
+  private def fail(): Nothing = throw new MalformedJsonException
+
+  private def skipWhitespace(): Unit =
+    while (c == ' ' || c == '\n' || c == '\r' || c == '\t') next()
+
+  private def expect(char: Char, text: java.lang.StringBuilder): Unit = {
+    if (c != char) fail()
+    if (text != null) text.append(char)
+    next()
+  }
+
+  /** Scans a string, appending it as it is written to `text`, and returns its value */
+  private def string(text: java.lang.StringBuilder): String = {
+    expect('"', text)
+    val value = new java.lang.StringBuilder
+    while (c != '"') {
+      if (c == -1) fail()
+      if (text != null) text.append(c.toChar)
+      if (c == '\\') {
+        next()
+        if (c == -1) fail()
+        if (text != null) text.append(c.toChar)
+        c match {
+          case 'b' => value.append('\b')
+          case 'f' => value.append('\f')
+          case 'n' => value.append('\n')
+          case 'r' => value.append('\r')
+          case 't' => value.append('\t')
+          case 'u' =>
+            var code = 0
+            for (_ <- 0 until 4) {
+              next()
+              val digit = Character.digit(c, 16)
+              if (digit < 0) fail()
+              if (text != null) text.append(c.toChar)
+              code = code * 16 + digit
+            }
+            value.append(code.toChar)
+          case other => value.append(other.toChar)
+        }
+      } else {
+        value.append(c.toChar)
+      }
+      next()
+    }
+    expect('"', text)
+    value.toString
+  }
+
+  /** Scans a value, appending it without whitespace to `text`, and calling `hint` with every "class" field */
+  private def value(text: java.lang.StringBuilder, hint: String => Unit): Unit = c match {
+    case '{' =>
+      expect('{', text)
+      skipWhitespace()
+      if (c != '}') {
+        var more = true
+        while (more) {
+          skipWhitespace()
+          val key = string(text)
+          skipWhitespace()
+          expect(':', text)
+          skipWhitespace()
+          if (key == "class" && c == '"') hint(string(text)) else value(text, hint)
+          skipWhitespace()
+          more = c == ','
+          if (more) expect(',', text)
+        }
+      }
+      expect('}', text)
+    case '[' =>
+      expect('[', text)
+      skipWhitespace()
+      if (c != ']') {
+        var more = true
+        while (more) {
+          skipWhitespace()
+          value(text, hint)
+          skipWhitespace()
+          more = c == ','
+          if (more) expect(',', text)
+        }
+      }
+      expect(']', text)
+    case '"' => string(text)
+    case _ => // a number, true, false or null
+      var empty = true
+      while (c != -1 && c != ',' && c != ']' && c != '}' && !Character.isWhitespace(c)) {
+        if (text != null) text.append(c.toChar)
+        empty = false
+        next()
+      }
+      if (empty) fail()
+  }
+
+  /** Scans the array, calling `element` with the text of each of its elements, if given, and `hint` with the value of
+    * every "class" field within them
+    *
+    * @throws MalformedJsonException if the JSON is not an array, or ends early
+    */
+  def scan(element: Option[String => Unit] = None, hint: String => Unit = _ => ()): Unit = {
+    skipWhitespace()
+    expect('[', null)
+    skipWhitespace()
+    if (c != ']') {
+      var more = true
+      while (more) {
+        skipWhitespace()
+        val text = element.map(_ => new java.lang.StringBuilder).orNull
+        value(text, hint)
+        element.foreach(_(text.toString))
+        skipWhitespace()
+        more = c == ','
+        if (more) next()
+      }
+    }
+    expect(']', null)
+    skipWhitespace()
+    if (c != -1) fail()
+  }
+}
+
+private[annotations] object JsonArrayScanner {
+  class MalformedJsonException extends Exception
+}
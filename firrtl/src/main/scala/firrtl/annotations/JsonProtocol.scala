@@ -16,6 +16,9 @@ import org.json4s.native.Serialization.{read, write, writePretty}
 
 import scala.collection.mutable
 
+import java.io.{BufferedReader, FileInputStream, InputStreamReader, Reader, StringReader}
+import java.nio.charset.StandardCharsets
+
 trait HasSerializationHints {
   // For serialization of complicated constructor arguments, let the annotation
   // writer specify additional type hints for relevant classes that might be
@@ -159,13 +162,16 @@ object JsonProtocol extends LazyLogging {
   ): Seq[(Annotation, Throwable)] =
     annos.map(a => a -> Try(write(a))).collect { case (a, Failure(e)) => (a, e) }
 
-  private def getTags(annos: Seq[Annotation]): Seq[Class[_]] =
-    annos
-      .flatMap({
-        case anno: HasSerializationHints => anno.getClass +: anno.typeHints
-        case anno => Seq(anno.getClass)
-      })
-      .distinct
+  private def getTags(annos: Seq[Annotation]): Seq[Class[_]] = {
+    val tags = mutable.LinkedHashSet[Class[_]]()
+    annos.foreach {
+      case anno: HasSerializationHints =>
+        tags += anno.getClass
+        tags ++= anno.typeHints
+      case anno => tags += anno.getClass
+    }
+    tags.toSeq
+  }
 
   def serializeTry(annos: Seq[Annotation]): Try[String] = {
     val tags = getTags(annos)
@@ -178,6 +184,33 @@ object JsonProtocol extends LazyLogging {
     }
   }
 
+  /** Serialize annotations lazily, one annotation at a time, for emission.
+    *
+    * The concatenation of the Strings is the same as the result of [[serialize]], but the JSON of only one annotation
+    * is built at a time.
+    */
+  def serializeLazily(annos: Seq[Annotation]): Iterator[String] =
+    if (annos.isEmpty) Iterator(serialize(annos))
+    else {
+      implicit val formats = jsonFormat(getTags(annos))
+      var end = ""
+      // Each annotation is written as the only element of an array, whose brackets become separators between them
+      annos.iterator.zipWithIndex.map {
+        case (anno, index) =>
+          val json =
+            try writePretty(Seq(anno))
+            catch {
+              case e: org.json4s.MappingException =>
+                val badAnnos = findUnserializeableAnnos(annos)
+                throw (if (badAnnos.isEmpty) e else UnserializableAnnotationException(badAnnos))
+            }
+          val start = json.indexOf('{')
+          val stop = json.lastIndexOf('}') + 1
+          end = json.substring(stop)
+          (if (index == 0) json.substring(0, start) else "," + json.substring(1, start)) + json.substring(start, stop)
+      } ++ Iterator(end)
+    }
+
   /** Serialize annotations to JSON while wrapping unserializeable ones with [[UnserializeableAnnotation]]
     *
     * @note this is slower than standard serialization
@@ -205,7 +238,46 @@ object JsonProtocol extends LazyLogging {
     deserializeTry(in, allowUnrecognizedAnnotations).get
   }
 
-  def deserializeTry(in: JsonInput, allowUnrecognizedAnnotations: Boolean = false): Try[Seq[Annotation]] = Try {
+  def deserializeTry(in: JsonInput, allowUnrecognizedAnnotations: Boolean = false): Try[Seq[Annotation]] =
+    deserializeLazily(in) match {
+      case Some(annos) => Success(annos)
+      case None        => deserializeAllTry(in, allowUnrecognizedAnnotations)
+    }
+
+  /** Deserialize the annotations in a file or String one at a time, without parsing all of their JSON at once.
+    *
+    * The array is scanned twice: first to find all of the type hints, which are each only loaded once, and then to
+    * extract each annotation. If anything goes wrong, e.g. an annotation is not recognized, this returns None, and
+    * [[deserializeAllTry]] should be used instead to handle it.
+    */
+  private[annotations] def deserializeLazily(in: JsonInput): Option[Seq[Annotation]] = {
+    def scan(f: JsonArrayScanner => Unit): Unit = {
+      val reader: Reader = in match {
+        case FileInput(file) =>
+          new BufferedReader(new InputStreamReader(new FileInputStream(file), StandardCharsets.UTF_8))
+        case StringInput(string) => new StringReader(string)
+        case _                   => throw new IllegalArgumentException
+      }
+      try f(new JsonArrayScanner(reader))
+      finally reader.close()
+    }
+    Try {
+      val classes = mutable.LinkedHashMap[String, Class[_]]()
+      scan(_.scan(hint = name => classes.getOrElseUpdate(name, Class.forName(name))))
+      implicit val formats = jsonFormat(classes.values.toSeq)
+      val annos = mutable.ArrayBuffer[Annotation]()
+      scan(_.scan(element = Some { text =>
+        val anno = parse(text)
+        anno \ "class" match {
+          case JString(_) => annos += anno.extract[Annotation]
+          case _          => throw new InvalidAnnotationJSONException(s"Expected field 'class' not found! $text")
+        }
+      }))
+      annos.toSeq
+    }.toOption
+  }
+
+  private def deserializeAllTry(in: JsonInput, allowUnrecognizedAnnotations: Boolean): Try[Seq[Annotation]] = Try {
     val parsed = parse(in)
     val annos = parsed match {
       case JArray(objs) => objs
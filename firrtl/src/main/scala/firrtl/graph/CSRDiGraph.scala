@@ -0,0 +1,452 @@
+// SPDX-License-Identifier: Apache-2.0
+
+package firrtl.graph
+
+import scala.collection.{mutable, Map, Set}
+import scala.collection.mutable.{LinkedHashMap, LinkedHashSet}
+
+import java.util.BitSet
+import java.util.concurrent.atomic.AtomicLongArray
+import java.util.stream.IntStream
+
+/** A companion to create CSRDiGraphs from DiGraphs or edges */
+object CSRDiGraph {
+
+  /** Frontiers of a breadth-first search at least this large are expanded in parallel */
+  private val ParallelFrontierSize = 4096
+
+  /** The per-vertex state of a breadth-first search, kept between searches so that each search does not allocate it
+    *
+    * Each search is given a new epoch, and entries stamped with an earlier epoch are treated as unset, so the
+    * arrays never need to be cleared.
+    */
+  private class SearchState(size: Int) {
+    var epoch = 0
+    var inUse = false
+    // The epoch in which each vertex was visited
+    val visited = new Array[Int](size)
+    // The epoch, in the upper 32 bits, and the position in the frontier of the first vertex to reach each vertex of
+    // the next frontier
+    val claims = new AtomicLongArray(size)
+
+    def begin(): Unit = {
+      if (epoch == Int.MaxValue) {
+        java.util.Arrays.fill(visited, 0)
+        (0 until size).foreach(claims.set(_, 0))
+        epoch = 0
+      }
+      epoch += 1
+    }
+
+    def isVisited(v: Int): Boolean = visited(v) == epoch
+
+    def claim(v: Int, position: Int): Unit = {
+      val stamp = epoch.toLong << 32
+      var done = false
+      while (!done) {
+        val old = claims.get(v)
+        done = ((old & ~0xffffffffL) == stamp && (old & 0xffffffffL) <= position) ||
+          claims.compareAndSet(v, old, stamp | position)
+      }
+    }
+
+    def claimedBy(v: Int, position: Int): Boolean = claims.get(v) == ((epoch.toLong << 32) | position)
+  }
+
+  /** Create a CSRDiGraph representing the same graph as a DiGraph, with vertices and edges in the same order */
+  def apply[T](graph: DiGraph[T]): CSRDiGraph[T] =
+    build(graph.edges.keys, addEdge => graph.edges.foreach { case (u, vs) => vs.foreach(addEdge(u, _)) })
+
+  /** Create a CSRDiGraph from vertices and edges
+    *
+    * Vertices are numbered in the order they are given, followed by any vertices that are only found in `edges`.
+    * Duplicate edges are dropped.
+    */
+  def apply[T](vertices: Iterable[T], edges: Iterable[(T, T)]): CSRDiGraph[T] =
+    build(vertices, addEdge => edges.foreach { case (u, v) => addEdge(u, v) })
+
+  private def build[T](vertices: Iterable[T], foreachEdge: ((T, T) => Unit) => Unit): CSRDiGraph[T] = {
+    val index = new mutable.HashMap[T, Int]
+    val order = new mutable.ArrayBuffer[Any]
+    def intern(v: T): Int = index.getOrElseUpdate(v, { order += v; order.size - 1 })
+    vertices.foreach(intern)
+    val sources = new mutable.ArrayBuilder.ofInt
+    val sinks = new mutable.ArrayBuilder.ofInt
+    foreachEdge { (u, v) =>
+      sources += intern(u)
+      sinks += intern(v)
+    }
+    val (offsets, targets) = compress(order.size, sources.result(), sinks.result())
+    new CSRDiGraph(order.toArray, index, offsets, targets)
+  }
+
+  /** Sorts edges by their source into compressed sparse rows, keeping the order of each source's edges and dropping
+    * duplicates
+    *
+    * @return the offset of each vertex's row in the targets, followed by the number of targets, and the targets
+    */
+  private def compress(size: Int, sources: Array[Int], sinks: Array[Int]): (Array[Int], Array[Int]) = {
+    val starts = new Array[Int](size + 1)
+    sources.foreach(u => starts(u + 1) += 1)
+    var i = 0
+    while (i < size) {
+      starts(i + 1) += starts(i)
+      i += 1
+    }
+    val cursors = java.util.Arrays.copyOf(starts, size)
+    val sorted = new Array[Int](sources.length)
+    var e = 0
+    while (e < sources.length) {
+      val u = sources(e)
+      sorted(cursors(u)) = sinks(e)
+      cursors(u) += 1
+      e += 1
+    }
+    // Compact the rows in place, each edge (u, v) is kept if v was last seen in a different row
+    val offsets = new Array[Int](size + 1)
+    val lastSource = Array.fill(size)(-1)
+    var count = 0
+    var u = 0
+    while (u < size) {
+      e = starts(u)
+      while (e < starts(u + 1)) {
+        val v = sorted(e)
+        if (lastSource(v) != u) {
+          lastSource(v) = u
+          sorted(count) = v
+          count += 1
+        }
+        e += 1
+      }
+      offsets(u + 1) = count
+      u += 1
+    }
+    (offsets, java.util.Arrays.copyOf(sorted, count))
+  }
+}
+
+/** A directed graph stored in compressed sparse row form, for graphs too large to store efficiently as a [[DiGraph]],
+  * such as the instance graphs of large designs
+  *
+  * Vertices are interned to the integers `0 until size`, and the edges of vertex `i` are the targets
+  * `targets(offsets(i))` until `targets(offsets(i + 1))`, so the graph needs no hash structures beyond the one used to
+  * find the index of a vertex. Algorithms work on the indices, and only look up vertices to build their results.
+  * Unlike [[DiGraph]], a CSRDiGraph is immutable.
+  */
+final class CSRDiGraph[T] private (
+  vertices: Array[Any],
+  index:    Map[T, Int],
+  offsets:  Array[Int],
+  targets:  Array[Int]) {
+  import CSRDiGraph._
+
+  // The search state of each thread, which is allocated by the thread's first search
+  private val searchState = new ThreadLocal[SearchState]
+
+  /** The number of vertices in the graph */
+  def size: Int = vertices.length
+
+  /** The number of edges in the graph */
+  def edgeCount: Int = targets.length
+
+  /** Get the vertex with index i */
+  def vertex(i: Int): T = vertices(i).asInstanceOf[T]
+
+  /** Get the index of vertex v, or -1 if v is not in the graph */
+  def indexOf(v: T): Int = index.getOrElse(v, -1)
+
+  /** Check whether the graph contains vertex v */
+  def contains(v: T): Boolean = index.contains(v)
+
+  /** Get all vertices in the graph, in the order of their indices */
+  def getVertices: IndexedSeq[T] = (0 until size).map(vertex)
+
+  /** Get all vertices that v has edges to */
+  def getEdges(v: T): Seq[T] = {
+    val i = indexOf(v)
+    if (i < 0) Seq.empty else (offsets(i) until offsets(i + 1)).map(e => vertex(targets(e)))
+  }
+
+  /** Get the indices of all vertices that vertex i has edges to */
+  def successors(i: Int): Array[Int] = java.util.Arrays.copyOfRange(targets, offsets(i), offsets(i + 1))
+
+  /** Get the number of edges from vertex i */
+  def outDegree(i: Int): Int = offsets(i + 1) - offsets(i)
+
+  /** Find all sources in the graph */
+  def findSources: Seq[T] = {
+    val hasInEdge = new BitSet(size)
+    targets.foreach(i => hasInEdge.set(i))
+    (0 until size).filterNot(i => hasInEdge.get(i)).map(vertex)
+  }
+
+  /** Find all sinks in the graph */
+  def findSinks: Seq[T] = (0 until size).filter(outDegree(_) == 0).map(vertex)
+
+  /** Returns a graph with all edges reversed, sharing the vertex indices of this graph
+    *
+    * The edges to each vertex are in the order of the indices of their sources, as for [[DiGraph.reverse]].
+    */
+  lazy val reverse: CSRDiGraph[T] = {
+    val sources = new Array[Int](edgeCount)
+    var u = 0
+    while (u < size) {
+      java.util.Arrays.fill(sources, offsets(u), offsets(u + 1), u)
+      u += 1
+    }
+    val (reverseOffsets, reverseTargets) = compress(size, targets, sources)
+    new CSRDiGraph(vertices, index, reverseOffsets, reverseTargets)
+  }
+
+  /** Depth-first search from each of `roots` not already finished, in order, calling `finish` with each vertex after
+    * all vertices reachable from it are finished
+    *
+    * @throws CyclicException if a cycle is reachable from the roots
+    */
+  private def postorder(roots: Iterator[Int], finish: Int => Unit): Unit = {
+    // 0 is unvisited, 1 is on the current path, and 2 is finished
+    val state = new Array[Byte](size)
+    // The call stack holds each vertex on the current path, and the next of its edges to visit
+    val callVertex = new Array[Int](size)
+    val callEdge = new Array[Int](size)
+    roots.filter(state(_) == 0).foreach { root =>
+      state(root) = 1
+      callVertex(0) = root
+      callEdge(0) = offsets(root)
+      var depth = 1
+      while (depth > 0) {
+        val v = callVertex(depth - 1)
+        val e = callEdge(depth - 1)
+        if (e < offsets(v + 1)) {
+          callEdge(depth - 1) = e + 1
+          val w = targets(e)
+          if (state(w) == 1) {
+            throw new CyclicException(vertex(w))
+          }
+          if (state(w) == 0) {
+            state(w) = 1
+            callVertex(depth) = w
+            callEdge(depth) = offsets(w)
+            depth += 1
+          }
+        } else {
+          state(v) = 2
+          finish(v)
+          depth -= 1
+        }
+      }
+    }
+  }
+
+  /** Linearizes (topologically sorts) a DAG, in the same order as [[DiGraph.linearize]]
+    *
+    * @throws CyclicException if the graph is cyclic
+    * @return a Seq[T] describing the topological order of the DAG traversal
+    */
+  def linearize: Seq[T] = {
+    val order = new mutable.ArrayBuilder.ofInt
+    postorder(Iterator.range(0, size), order += _)
+    order.result().reverseIterator.map(vertex).toIndexedSeq
+  }
+
+  /** Finds the strongly connected components in the graph, with Tarjan's algorithm
+    *
+    * @return a Seq of Seq[T], each containing nodes of an SCC in traversable order
+    */
+  def findSCCs: Seq[Seq[T]] = {
+    val indices = Array.fill(size)(-1)
+    val lowlinks = new Array[Int](size)
+    val onStack = new Array[Boolean](size)
+    val stack = new Array[Int](size)
+    var stackSize = 0
+    val callVertex = new Array[Int](size)
+    val callEdge = new Array[Int](size)
+    var depth = 0
+    var counter = 0
+    val sccs = new mutable.ArrayBuffer[Seq[T]]
+
+    def visit(v: Int): Unit = {
+      indices(v) = counter
+      lowlinks(v) = counter
+      counter += 1
+      stack(stackSize) = v
+      stackSize += 1
+      onStack(v) = true
+      callVertex(depth) = v
+      callEdge(depth) = offsets(v)
+      depth += 1
+    }
+
+    for (root <- 0 until size if indices(root) < 0) {
+      visit(root)
+      while (depth > 0) {
+        val v = callVertex(depth - 1)
+        val e = callEdge(depth - 1)
+        if (e < offsets(v + 1)) {
+          callEdge(depth - 1) = e + 1
+          val w = targets(e)
+          if (indices(w) < 0) {
+            visit(w)
+          } else if (onStack(w)) {
+            lowlinks(v) = lowlinks(v).min(indices(w))
+          }
+        } else {
+          depth -= 1
+          if (lowlinks(v) == indices(v)) {
+            val scc = new mutable.ArrayBuffer[T]
+            var w = -1
+            do {
+              stackSize -= 1
+              w = stack(stackSize)
+              onStack(w) = false
+              scc += vertex(w)
+            } while (w != v)
+            sccs += scc.toSeq
+          }
+          if (depth > 0) {
+            val parent = callVertex(depth - 1)
+            lowlinks(parent) = lowlinks(parent).min(lowlinks(v))
+          }
+        }
+      }
+    }
+
+    sccs.toSeq
+  }
+
+  /** Finds the indices of the vertices reachable from a particular vertex, with a blacklist, in the same order as
+    * [[DiGraph.reachableFrom]]
+    *
+    * This is a level-synchronous breadth-first search, which expands large frontiers in parallel. Each newly reached
+    * vertex is claimed by the first vertex of the frontier that reaches it, so the result does not depend on how the
+    * frontier is scheduled.
+    *
+    * @param root the index of the start vertex, which is only included if it is on a cycle
+    * @param blacklist the indices of vertices whose inedges are ignored
+    */
+  def reachableIndices(root: Int, blacklist: BitSet = new BitSet): Array[Int] = {
+    // A thread can run another search while it waits for a parallel frontier, which is given its own state
+    val state = Option(searchState.get).filterNot(_.inUse).getOrElse {
+      val state = new SearchState(size)
+      if (searchState.get == null) searchState.set(state)
+      state
+    }
+    state.inUse = true
+    state.begin()
+    try {
+      val levels = new mutable.ArrayBuffer[Array[Int]]
+      var frontier = Array(root)
+      while (frontier.nonEmpty) {
+        val current = frontier
+        def positions = {
+          val stream = IntStream.range(0, current.length)
+          if (current.length >= ParallelFrontierSize) stream.parallel() else stream
+        }
+        def edges(position: Int) = {
+          val u = current(position)
+          IntStream.range(offsets(u), offsets(u + 1)).map(targets(_))
+        }
+        // visited is only written between levels, so it is safe to read while the frontier is expanded
+        positions.forEach { position =>
+          edges(position).forEach { w =>
+            if (!state.isVisited(w) && !blacklist.get(w)) {
+              state.claim(w, position)
+            }
+          }
+        }
+        frontier = positions.flatMap { position =>
+          edges(position).filter(w => state.claimedBy(w, position) && !state.isVisited(w))
+        }.toArray
+        frontier.foreach(w => state.visited(w) = state.epoch)
+        levels += frontier
+      }
+      levels.flatten.toArray
+    } finally {
+      state.inUse = false
+    }
+  }
+
+  /** Finds the set of nodes reachable from a particular node, with a blacklist, as for [[DiGraph.reachableFrom]]
+    *
+    * @param root the start node
+    * @param blacklist list of nodes to stop searching, if encountered
+    * @return a Set[T] of nodes reachable from `root`
+    */
+  def reachableFrom(root: T, blacklist: Set[T] = Set.empty[T]): LinkedHashSet[T] = {
+    val blacklisted = new BitSet(size)
+    blacklist.foreach(v => if (contains(v)) blacklisted.set(indexOf(v)))
+    val reachable = new LinkedHashSet[T]
+    if (contains(root)) {
+      reachable ++= reachableIndices(indexOf(root), blacklisted).iterator.map(vertex)
+    }
+    reachable
+  }
+
+  /** Counts all paths starting at a particular node in a DAG
+    *
+    * Unlike [[DiGraph.pathsInDAG]], this takes time linear in the size of the graph, as paths are counted rather than
+    * materialized. Only the part of the graph reachable from `start` must be acyclic.
+    *
+    * @param start the node to start at
+    * @throws java.lang.IllegalArgumentException if start is not in the graph
+    * @throws CyclicException if a cycle is reachable from `start`
+    * @return a Map[T,BigInt] where the value associated with v is the number of paths from start to v, in topological
+    * order
+    */
+  def countPathsInDAG(start: T): LinkedHashMap[T, BigInt] = {
+    require(contains(start))
+    val order = new mutable.ArrayBuilder.ofInt
+    postorder(Iterator.single(indexOf(start)), order += _)
+    val counts = new Array[BigInt](size)
+    counts(indexOf(start)) = 1
+    val result = new LinkedHashMap[T, BigInt]
+    order.result().reverseIterator.foreach { u =>
+      var e = offsets(u)
+      while (e < offsets(u + 1)) {
+        val w = targets(e)
+        counts(w) = if (counts(w) == null) counts(u) else counts(w) + counts(u)
+        e += 1
+      }
+      result(vertex(u)) = counts(u)
+    }
+    result
+  }
+
+  /** Return a graph with only a subset of the nodes, keeping their order
+    *
+    * Any edge including a deleted node will be deleted
+    *
+    * @param vprime the Set[T] of desired vertices
+    * @throws java.lang.IllegalArgumentException if vprime is not a subset of V
+    * @return the subgraph
+    */
+  def subgraph(vprime: Set[T]): CSRDiGraph[T] = {
+    require(vprime.forall(contains))
+    val renumbered = Array.fill(size)(-1)
+    val kept = new mutable.ArrayBuffer[Any]
+    val keptIndex = new mutable.HashMap[T, Int]
+    for (i <- 0 until size if vprime.contains(vertex(i))) {
+      renumbered(i) = kept.size
+      keptIndex(vertex(i)) = kept.size
+      kept += vertex(i)
+    }
+    val sources = new mutable.ArrayBuilder.ofInt
+    val sinks = new mutable.ArrayBuilder.ofInt
+    for (u <- 0 until size if renumbered(u) >= 0; e <- offsets(u) until offsets(u + 1) if renumbered(targets(e)) >= 0) {
+      sources += renumbered(u)
+      sinks += renumbered(targets(e))
+    }
+    val (keptOffsets, keptTargets) = compress(kept.size, sources.result(), sinks.result())
+    new CSRDiGraph(kept.toArray, keptIndex, keptOffsets, keptTargets)
+  }
+
+  /** Returns a DiGraph representing the same graph */
+  def toDiGraph: DiGraph[T] = {
+    val mdg = new MutableDiGraph[T]
+    getVertices.foreach(mdg.addVertex)
+    for (u <- 0 until size; e <- offsets(u) until offsets(u + 1)) {
+      mdg.addEdge(vertex(u), vertex(targets(e)))
+    }
+    DiGraph(mdg)
+  }
+}
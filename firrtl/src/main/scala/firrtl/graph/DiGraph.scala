@@ -398,6 +398,10 @@ class DiGraph[T](private[graph] val edges: LinkedHashMap[T, LinkedHashSet[T]]) {
     new DiGraph(eprime)
   }
 
+  /** Returns a [[CSRDiGraph]] representing the same graph, which is more compact and faster to search for large graphs
+    */
+  def toCSR: CSRDiGraph[T] = CSRDiGraph(this)
+
   /** Serializes a `DiGraph[String]` as a pretty tree
     *
     * Multiple roots are supported, but cycles are not.
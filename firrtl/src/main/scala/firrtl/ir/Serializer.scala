@@ -395,7 +395,6 @@ object Serializer {
   private def sIt(node: Circuit)(implicit indent: Int): Iterator[String] =
     sIt(CircuitWithAnnos(node, Nil))
 
-  // TODO make Annotation serialization lazy
   private def sIt(node: CircuitWithAnnos)(implicit indent: Int): Iterator[String] = {
     val CircuitWithAnnos(circuit, annotations) = node
     val prelude = {
@@ -403,10 +402,15 @@ object Serializer {
       b ++= s"FIRRTL version ${version.serialize}\n"
       b ++= "circuit "; b ++= circuit.main; b ++= " :";
       if (annotations.nonEmpty) {
-        b ++= "%["; b ++= JsonProtocol.serialize(annotations); b ++= "]";
+        b ++= "%["
+        val header = b.toString
+        b.clear()
+        b ++= "]"; s(circuit.info)
+        Iterator(header) ++ JsonProtocol.serializeLazily(annotations) ++ Iterator(b.toString)
+      } else {
+        s(circuit.info)
+        Iterator(b.toString)
       }
-      s(circuit.info)
-      Iterator(b.toString)
     }
     prelude ++
       circuit.modules.iterator.zipWithIndex.flatMap {
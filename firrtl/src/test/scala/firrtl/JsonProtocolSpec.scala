@@ -80,4 +80,23 @@ class JsonProtocolSpec extends AnyFlatSpec {
     val deserAnno = JsonProtocol.deserialize(serializedAnno).head
     assert(anno == deserAnno)
   }
+
+  "Lazy serialization" should "produce the same JSON as serialization" in {
+    val annos = Seq(
+      SimpleAnnotation("hello"),
+      PolymorphicParameterAnnotationWithTypeHints(ChildA(1)),
+      SimpleAnnotation("with \"quotes\", [brackets] and {braces}\n")
+    )
+    assert(JsonProtocol.serializeLazily(annos).mkString == JsonProtocol.serialize(annos))
+    assert(JsonProtocol.serializeLazily(Nil).mkString == JsonProtocol.serialize(Nil))
+  }
+
+  "Deserialization" should "read back many annotations with nested type hints and escapes" in {
+    val annos = Seq.tabulate(100) {
+      case i if i % 3 == 0 => PolymorphicParameterAnnotationWithTypeHints(ChildB("back\\slash\t" + i))
+      case i if i % 3 == 1 => PolymorphicParameterAnnotationWithTypeHints(ChildA(i))
+      case i               => SimpleAnnotation("caf\u00e9 \"" + i + "\" }]")
+    }
+    assert(JsonProtocol.deserialize(JsonProtocol.serialize(annos)) == annos)
+  }
 }
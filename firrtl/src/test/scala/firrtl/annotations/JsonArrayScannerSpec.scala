@@ -0,0 +1,65 @@
+// SPDX-License-Identifier: Apache-2.0
+
+package firrtl.annotations
+
+import firrtlTests.JsonProtocolTestClasses._
+import org.json4s._
+import org.scalatest.flatspec.AnyFlatSpec
+import org.scalatest.matchers.should.Matchers
+
+import java.io.StringReader
+import scala.collection.mutable
+
+class JsonArrayScannerSpec extends AnyFlatSpec with Matchers {
+
+  /** The text of each element of `json`, and the "class" fields within them */
+  private def scan(json: String): (Seq[String], Seq[String]) = {
+    val elements = mutable.ArrayBuffer[String]()
+    val hints = mutable.ArrayBuffer[String]()
+    val element: String => Unit = elements += _
+    new JsonArrayScanner(new StringReader(json)).scan(Some(element), hints += _)
+    (elements.toSeq, hints.toSeq)
+  }
+
+  "JsonArrayScanner" should "split an array into the text of its elements, without whitespace outside strings" in {
+    scan(""" [ { "a" : 1 , "b" : [ true, null ] } ,
+           |  "s p a c e" , -1.5e3 , [ ] , { } ] """.stripMargin) should be(
+      (Seq("""{"a":1,"b":[true,null]}""", "\"s p a c e\"", "-1.5e3", "[]", "{}"), Nil)
+    )
+    scan("[]") should be((Nil, Nil))
+  }
+
+  it should "keep escapes and brackets within strings as they are written" in {
+    val element = """{"a":"q\"],[{\\","b":"]\n\t","c":["]","[",{"d":"}"}]}"""
+    scan(s"[$element, $element]") should be((Seq(element, element), Nil))
+  }
+
+  it should "find the type hints of nested objects" in {
+    scan("""[{"class":"A","p":{"class":"B","q":[{"class":"C"}]}},{"x":"class","class":"D"}]""")._2 should be(
+      Seq("A", "B", "C", "D")
+    )
+    // Only string values of "class" fields are hints, and escapes in them are decoded
+    scan("""[{"class":1,"y":{"class":"a\"bc"}}]""")._2 should be(Seq("a\"bc"))
+  }
+
+  it should "reject input which is not a well-formed array" in {
+    for (json <- Seq("", "{}", "[1,2", """["unterminated]""", "[1] 2", "[\"\\u00zz\"]", "[{,}]")) {
+      a[JsonArrayScanner.MalformedJsonException] should be thrownBy scan(json)
+    }
+  }
+
+  "JsonProtocol.deserializeLazily" should "read annotations with escapes and brackets in their strings" in {
+    val annos = Seq(
+      SimpleAnnotation("quotes \" and ] brackets [ and } braces {"),
+      PolymorphicParameterAnnotationWithTypeHints(ChildB("back\\slash\té \"]\""))
+    )
+    JsonProtocol.deserializeLazily(JsonProtocol.serialize(annos)) should be(Some(annos))
+  }
+
+  it should "give up on annotations which it cannot read, to leave them to the complete parser" in {
+    JsonProtocol.deserializeLazily("""[{"class":"not.a.Class"}]""") should be(None)
+    JsonProtocol.deserializeLazily("""[{"alpha":"no class"}]""") should be(None)
+    val truncated = s"""[{"class":"${classOf[SimpleAnnotation].getName}""""
+    JsonProtocol.deserializeLazily(truncated) should be(None)
+  }
+}
@@ -0,0 +1,139 @@
+// SPDX-License-Identifier: Apache-2.0
+
+package firrtlTests.graph
+
+import firrtl.graph._
+import firrtl.testutils._
+
+import scala.concurrent.{Await, Future}
+import scala.concurrent.ExecutionContext.Implicits.global
+import scala.concurrent.duration.Duration
+import scala.util.Random
+
+class CSRDiGraphTests extends FirrtlFlatSpec {
+
+  val acyclicGraph = DiGraph(
+    Map("a" -> Set("b", "c"), "b" -> Set("d"), "c" -> Set("d"), "d" -> Set("e"), "e" -> Set.empty[String])
+  )
+
+  val cyclicGraph = DiGraph(Map("a" -> Set("b", "c"), "b" -> Set("d"), "c" -> Set("d"), "d" -> Set("a")))
+
+  /** A random graph, with a few cycles if `cyclic` */
+  def randomGraph(random: Random, size: Int, cyclic: Boolean): DiGraph[Int] = {
+    val edges = Seq.fill(size * 2) {
+      val (u, v) = (random.nextInt(size), random.nextInt(size))
+      if (cyclic || u < v) (u, v) else (v, u)
+    }
+    DiGraph((0 until size).map(_ -> Set.empty[Int]).toMap) + DiGraph(edges.filter { case (u, v) => u != v }: _*)
+  }
+
+  "A CSRDiGraph" should "have the same vertices and edges as the DiGraph it was built from" in {
+    val csr = acyclicGraph.toCSR
+    csr.getVertices should be(acyclicGraph.getVertices.toSeq)
+    csr.getVertices.foreach(v => csr.getEdges(v) should be(acyclicGraph.getEdges(v).toSeq))
+    csr.edgeCount should be(5)
+    csr.toDiGraph.getEdgeMap should equal(acyclicGraph.getEdgeMap)
+  }
+
+  it should "intern vertices only found in edges, and drop duplicate edges" in {
+    val csr = CSRDiGraph(Seq("a"), Seq("a" -> "b", "b" -> "c", "a" -> "b"))
+    csr.getVertices should be(Seq("a", "b", "c"))
+    csr.getEdges("a") should be(Seq("b"))
+    csr.indexOf("c") should be(2)
+    csr.indexOf("d") should be(-1)
+  }
+
+  it should "find sources and sinks" in {
+    acyclicGraph.toCSR.findSources should be(Seq("a"))
+    acyclicGraph.toCSR.findSinks should be(Seq("e"))
+  }
+
+  "Reversing a CSRDiGraph" should "be the same as reversing a DiGraph" in {
+    acyclicGraph.toCSR.reverse.toDiGraph.getEdgeMap should equal(acyclicGraph.reverse.getEdgeMap)
+    cyclicGraph.toCSR.reverse.toDiGraph.getEdgeMap should equal(cyclicGraph.reverse.getEdgeMap)
+  }
+
+  "A CSRDiGraph" should "linearize in the same order as a DiGraph" in {
+    val random = new Random(0)
+    for (_ <- 0 until 20) {
+      val graph = randomGraph(random, 50, cyclic = false)
+      graph.toCSR.linearize should be(graph.linearize)
+    }
+  }
+
+  it should "error when linearized with a cycle" in {
+    val c = the[CyclicException] thrownBy cyclicGraph.toCSR.linearize
+    c.node.asInstanceOf[String] should be("a")
+  }
+
+  it should "not cause a stack overflow on very large graphs" in {
+    val N = 100000
+    val csr = CSRDiGraph(0 to N, (0 until N).map(n => n -> (n + 1)))
+    csr.linearize should be(0 to N)
+    csr.findSCCs should have size (N + 1)
+  }
+
+  "Finding SCCs in a CSRDiGraph" should "find each strongly connected component once" in {
+    cyclicGraph.toCSR.findSCCs.map(_.toSet) should contain theSameElementsAs Seq(Set("a", "b", "c", "d"))
+    val random = new Random(1)
+    for (_ <- 0 until 20) {
+      val csr = randomGraph(random, 50, cyclic = true).toCSR
+      val sccs = csr.findSCCs
+      sccs.flatten should contain theSameElementsAs csr.getVertices
+      val component = sccs.zipWithIndex.flatMap { case (scc, i) => scc.map(_ -> i) }.toMap
+      for (u <- csr.getVertices; v <- csr.getVertices) {
+        val connected = csr.reachableFrom(u).contains(v) && csr.reachableFrom(v).contains(u)
+        (component(u) == component(v)) should be(u == v || connected)
+      }
+    }
+  }
+
+  "reachableFrom on a CSRDiGraph" should "be the same as on a DiGraph" in {
+    acyclicGraph.toCSR.reachableFrom("a") should be(acyclicGraph.reachableFrom("a"))
+    acyclicGraph.toCSR.reachableFrom("e") shouldBe empty
+    cyclicGraph.toCSR.reachableFrom("b").toSeq should be(cyclicGraph.reachableFrom("b").toSeq)
+    acyclicGraph.toCSR.reachableFrom("a", Set("b")).toSeq should be(acyclicGraph.reachableFrom("a", Set("b")).toSeq)
+  }
+
+  it should "find the same vertices in the same order when searching in parallel" in {
+    val random = new Random(2)
+    val graph = randomGraph(random, 100000, cyclic = true)
+    val csr = graph.toCSR
+    for (root <- Seq(0, 1, 2)) {
+      csr.reachableFrom(root).toSeq should be(graph.reachableFrom(root).toSeq)
+    }
+  }
+
+  it should "give the same results when searches are repeated, and run concurrently" in {
+    val random = new Random(4)
+    val graph = randomGraph(random, 20000, cyclic = true)
+    val csr = graph.toCSR
+    val roots = (0 until 8).map(_ => random.nextInt(20000))
+    val expected = roots.map(root => graph.reachableFrom(root, Set(roots.head)).toSeq)
+    roots.map(root => csr.reachableFrom(root, Set(roots.head)).toSeq) should be(expected)
+    // Searches from several threads at once, each of which also waits on its own parallel frontiers
+    val searches = roots.map(root => Future(csr.reachableFrom(root, Set(roots.head)).toSeq))
+    searches.map(Await.result(_, Duration.Inf)) should be(expected)
+  }
+
+  "Counting paths in a CSRDiGraph" should "count the paths found in a DiGraph" in {
+    val random = new Random(3)
+    for (_ <- 0 until 20) {
+      val graph = randomGraph(random, 30, cyclic = false)
+      val counts = graph.toCSR.countPathsInDAG(0)
+      counts.toMap should equal(graph.pathsInDAG(0).map { case (v, paths) => v -> BigInt(paths.size) }.toMap)
+    }
+  }
+
+  it should "error if a cycle is reachable" in {
+    a[CyclicException] should be thrownBy cyclicGraph.toCSR.countPathsInDAG("b")
+    acyclicGraph.toCSR.countPathsInDAG("a").toSeq should be(
+      Seq("a" -> BigInt(1), "c" -> BigInt(1), "b" -> BigInt(1), "d" -> BigInt(2), "e" -> BigInt(2))
+    )
+  }
+
+  "A CSRDiGraph subgraph" should "be the same as a DiGraph subgraph" in {
+    val vprime = Set("a", "b", "d")
+    acyclicGraph.toCSR.subgraph(vprime).toDiGraph.getEdgeMap should equal(acyclicGraph.subgraph(vprime).getEdgeMap)
+  }
+}
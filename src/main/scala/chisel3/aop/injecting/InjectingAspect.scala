@@ -62,7 +62,8 @@ abstract class InjectorAspect[T <: RawModule, M <: RawModule](
           annotationsInAspect,
           chiselOptions.throwOnFirstError,
           chiselOptions.warningsAsErrors,
-          chiselOptions.sourceRoots
+          chiselOptions.sourceRoots,
+          chiselOptions.definitionThreads
         )
       // Add existing module names into the namespace. If injection logic instantiates new modules
       //  which would share the same name, they will get uniquified accordingly
@@ -0,0 +1,71 @@
+// SPDX-License-Identifier: Apache-2.0
+
+package chisel3.simulator
+
+import svsim.CommonCompilationSettings
+
+import java.io.File
+import java.nio.file.{Files, StandardCopyOption}
+import java.security.MessageDigest
+
+/** An on-disk cache of the artifacts produced when simulating a [[chisel3.experimental.SerializableModuleGenerator]], which can be shared across runs and by concurrent processes (for instance, repeated CI runs over unchanged generators).
+  *
+  * The SystemVerilog emitted for a generator is keyed by the generator's serialized form (its class and parameters) and the Chisel and `firtool` versions, and a hit skips running `firtool`. The generator itself is always run, since simulations need the elaborated module to interact with its ports. As with [[chisel3.experimental.SerializableModule]] itself, the user is responsible for making sure that a generator's output depends only on its parameters.
+  *
+  * @param path The directory in which artifacts are stored.
+  * @param cacheSimulations Whether to also cache compiled simulations, which skips the backend compiler (for instance, Verilator and the C++ compiler) on a hit. Compiled simulations are keyed by the content of their sources, the backend's version and the compilation settings, so they are only reused when valid. This is only supported by backends which support `svsim.CommonCompilationSettings.SimulationCache`.
+  */
+final case class ArtifactCache(path: String, cacheSimulations: Boolean = true) {
+  private def sourcesPath = s"$path/sources"
+
+  private[simulator] def simulationCache: Option[CommonCompilationSettings.SimulationCache] =
+    if (cacheSimulations) Some(CommonCompilationSettings.SimulationCache(s"$path/simulations")) else None
+
+  private[simulator] def sourcesKey(serializedGenerator: String): String = {
+    val digest = MessageDigest.getInstance("SHA-256")
+    Seq(chisel3.BuildInfo.version, circt.stage.phases.CIRCT.installedFirtoolVersion, serializedGenerator).foreach { component =>
+      digest.update(component.getBytes("UTF-8"))
+      digest.update(0.toByte)
+    }
+    digest.digest().map("%02x".format(_)).mkString
+  }
+
+  /** Copies the sources cached under `key` into `destination`, returning `false` if there is no such entry.
+    */
+  private[simulator] def restoreSources(key: String, destination: String): Boolean = {
+    val entry = new File(sourcesPath, key)
+    if (!entry.isDirectory()) {
+      false
+    } else {
+      entry.listFiles().foreach { file =>
+        Files.copy(file.toPath(), new File(destination, file.getName()).toPath(), StandardCopyOption.REPLACE_EXISTING)
+      }
+      true
+    }
+  }
+
+  /** Stores the files in `source` under `key`. Entries are staged in a temporary directory which is atomically moved into place, so a partially written entry is never observed.
+    */
+  private[simulator] def storeSources(key: String, source: String): Unit = {
+    val cacheDirectory = new File(sourcesPath)
+    cacheDirectory.mkdirs()
+    val entry = new File(cacheDirectory, key)
+    if (!entry.exists()) {
+      val stagingDirectory = Files.createTempDirectory(cacheDirectory.toPath(), s"$key.staging-").toFile()
+      try {
+        new File(source).listFiles().foreach { file =>
+          Files.copy(file.toPath(), new File(stagingDirectory, file.getName()).toPath())
+        }
+        Files.move(stagingDirectory.toPath(), entry.toPath(), StandardCopyOption.ATOMIC_MOVE)
+      } catch {
+        // Another process stored the same entry first
+        case _: java.nio.file.FileAlreadyExistsException | _: java.nio.file.DirectoryNotEmptyException =>
+      } finally {
+        if (stagingDirectory.exists()) {
+          stagingDirectory.listFiles().foreach(_.delete())
+          stagingDirectory.delete()
+        }
+      }
+    }
+  }
+}
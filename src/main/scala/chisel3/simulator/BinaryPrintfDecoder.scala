@@ -0,0 +1,138 @@
+// SPDX-License-Identifier: Apache-2.0
+
+package chisel3.simulator
+
+import java.io.{BufferedInputStream, EOFException, File, FileInputStream, InputStream, PrintWriter, Writer}
+import java.nio.charset.StandardCharsets
+import java.nio.file.Files
+
+/** Formats the records of printfs lowered to binary records, see [[chisel3.stage.BinaryPrintfAnnotation]]
+  *
+  * Each record is a printf's id, the number of words of its arguments, and those words, least significant first, all
+  * as little-endian 32-bit values. Arguments are formatted as Verilog's `fwrite` task would format them, so the output
+  * matches what the printfs would have printed in simulation.
+  *
+  * @param formats the format of each printf, indexed by its id
+  */
+class BinaryPrintfDecoder(formats: IndexedSeq[Seq[BinaryPrintfDecoder.Part]]) {
+  import BinaryPrintfDecoder._
+
+  private val wordCounts = formats.map(_.collect { case argument: Argument => argument.words }.sum)
+
+  /** Formats every record in `input`, writing the messages to `output`
+    *
+    * @throws java.lang.IllegalArgumentException if a record has an unknown id, or the wrong number of words
+    * @throws java.io.EOFException if the last record is incomplete
+    */
+  def decode(input: InputStream, output: Writer): Unit = {
+    val in = new BufferedInputStream(input)
+    def readWord(): Option[Int] = {
+      val b0 = in.read()
+      if (b0 < 0) None
+      else {
+        val (b1, b2, b3) = (in.read(), in.read(), in.read())
+        if (b3 < 0) throw new EOFException("Incomplete binary printf record")
+        Some(b0 | (b1 << 8) | (b2 << 16) | (b3 << 24))
+      }
+    }
+    def nextWord(): Int = readWord().getOrElse(throw new EOFException("Incomplete binary printf record"))
+
+    var record = readWord()
+    while (record.isDefined) {
+      val id = record.get
+      require(id >= 0 && id < formats.size, s"Unknown binary printf id $id")
+      val count = nextWord()
+      require(count == wordCounts(id), s"Binary printf $id has $count words, but its arguments are ${wordCounts(id)}")
+      val words = Array.fill(count)(nextWord())
+      var offset = 0
+      formats(id).foreach {
+        case Text(text) => output.write(text)
+        case argument: Argument =>
+          output.write(argument.format(words, offset))
+          offset += argument.words
+      }
+      record = readWord()
+    }
+    output.flush()
+  }
+
+  /** Formats every record in a file, writing the messages to `output` */
+  def decode(file: File, output: Writer): Unit = {
+    val input = new FileInputStream(file)
+    try decode(input, output)
+    finally input.close()
+  }
+}
+
+object BinaryPrintfDecoder {
+
+  /** A part of the format of a printf */
+  sealed trait Part
+
+  /** Text which is printed as is */
+  case class Text(text: String) extends Part
+
+  /** An argument of a printf
+    *
+    * @param specifier the format specifier: `d`, `x`, `b` or `c`
+    * @param width the width of the argument
+    * @param signed whether the argument is signed, which only affects how `d` is formatted
+    */
+  case class Argument(specifier: Char, width: Int, signed: Boolean) extends Part {
+    require("dxbc".contains(specifier), s"Illegal format specifier '$specifier'")
+
+    /** The number of words the argument is recorded in */
+    val words: Int = ((width + 31) / 32).max(1)
+
+    /** Formats the argument, which is recorded in the `words` words at `offset` */
+    def format(record: Array[Int], offset: Int): String = {
+      val bits = (0 until words).foldRight(BigInt(0)) {
+        case (i, acc) => (acc << 32) | (BigInt(record(offset + i)) & 0xffffffffL)
+      } & ((BigInt(1) << width) - 1)
+      // Like Verilog, decimals are padded with spaces to the width of the largest value, and other radixes with zeros
+      specifier match {
+        case 'd' if signed && width > 0 && bits.testBit(width - 1) =>
+          val value = bits - (BigInt(1) << width)
+          pad(value.toString, (BigInt(1) << (width - 1)).toString.length + 1, ' ')
+        case 'd' if signed => pad(bits.toString, (BigInt(1) << (width - 1).max(0)).toString.length + 1, ' ')
+        case 'd'           => pad(bits.toString, ((BigInt(1) << width) - 1).toString.length, ' ')
+        case 'x'           => pad(bits.toString(16), (width + 3) / 4, '0')
+        case 'b'           => pad(bits.toString(2), width, '0')
+        case 'c'           => (bits & 0xff).toChar.toString
+      }
+    }
+  }
+
+  private def pad(string: String, width: Int, char: Char): String = char.toString * (width - string.length) + string
+
+  /** Reads the formats written at elaboration, see [[chisel3.stage.BinaryPrintfAnnotation]] */
+  def fromTable(json: String): BinaryPrintfDecoder = {
+    val table = ujson.read(json)
+    require(table("wordWidth").num == 32, "Binary printf records must have 32-bit words")
+    val formats = table("formats").arr.map { format =>
+      format("parts").arr.map { part =>
+        part.obj.get("text") match {
+          case Some(text) => Text(text.str)
+          case None       => Argument(part("format").str.head, part("width").num.toInt, part("signed").bool)
+        }
+      }.toSeq
+    }
+    new BinaryPrintfDecoder(formats.toIndexedSeq)
+  }
+
+  /** Reads the formats written at elaboration from a file */
+  def fromTable(file: File): BinaryPrintfDecoder =
+    fromTable(new String(Files.readAllBytes(file.toPath), StandardCharsets.UTF_8))
+
+  /** Formats the records of a simulation offline
+    *
+    * Run with `BinaryPrintfDecoder <formats.json> <binary-printf.bin> [<output.txt>]`. The messages are written to the
+    * given file, or to `stdout` if no file is given.
+    */
+  def main(args: Array[String]): Unit = {
+    require(args.length == 2 || args.length == 3, "usage: BinaryPrintfDecoder <formats> <records> [<output>]")
+    val output = if (args.length == 3) new PrintWriter(args(2)) else new PrintWriter(System.out)
+    try fromTable(new File(args(0))).decode(new File(args(1)), output)
+    finally output.close()
+  }
+}
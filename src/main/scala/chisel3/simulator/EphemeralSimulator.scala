@@ -2,6 +2,8 @@ package chisel3.simulator
 
 import svsim._
 import chisel3.RawModule
+import chisel3.experimental.{SerializableModule, SerializableModuleGenerator, SerializableModuleParameter}
+import upickle.default.ReadWriter
 
 /** Provides a simple API for "ephemeral" invocations (where you don't care about the artifacts after the invocation completes) to
   * simulate Chisel modules. To keep things really simple, `EphemeralSimulator` simulations can only be controlled using the
@@ -18,9 +20,33 @@ object EphemeralSimulator extends PeekPokeAPI {
   def simulate[T <: RawModule](
     module: => T
   )(body:   (T) => Unit
+  ): Unit = {
+    simulateWithPhaseTimings(module)(body)
+  }
+
+  /** Like `simulate`, but returns the timing of each phase of the simulation, from elaboration through running `body`.
+    */
+  def simulateWithPhaseTimings[T <: RawModule](
+    module: => T
+  )(body:   (T) => Unit
+  ): Seq[PhaseTiming] = {
+    synchronized {
+      val digest = simulator.simulate(module)({ (_, dut) => body(dut) })
+      digest.result
+      digest.phaseTimings
+    }
+  }
+
+  /** Like `simulate`, but if the `CHISEL_ARTIFACT_CACHE` environment variable is set, reuses the artifacts of previous simulations of the same generator which are cached in the directory it names (see [[ArtifactCache]]).
+    */
+  def simulate[M <: RawModule with SerializableModule[P], P <: SerializableModuleParameter](
+    generator: SerializableModuleGenerator[M, P]
+  )(body:      (M) => Unit
+  )(
+    implicit rwP: ReadWriter[P]
   ): Unit = {
     synchronized {
-      simulator.simulate(module)({ (_, dut) => body(dut) }).result
+      simulator.simulate(generator)({ (_, dut) => body(dut) }).result
     }
   }
 
@@ -29,6 +55,7 @@ object EphemeralSimulator extends PeekPokeAPI {
     val tag = "default"
     val commonCompilationSettings = CommonCompilationSettings()
     val backendSpecificCompilationSettings = verilator.Backend.CompilationSettings()
+    override val artifactCache = sys.env.get("CHISEL_ARTIFACT_CACHE").map(ArtifactCache(_))
 
     // Try to clean up temporary workspace if possible
     sys.addShutdownHook {
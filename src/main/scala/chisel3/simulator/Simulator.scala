@@ -1,8 +1,10 @@
 package chisel3.simulator
 
 import chisel3.{Data, RawModule}
+import chisel3.experimental.{SerializableModule, SerializableModuleGenerator, SerializableModuleParameter}
 import scala.util.Try
 import svsim._
+import upickle.default.ReadWriter
 
 final object Simulator {
   trait BackendProcessor {
@@ -14,10 +16,15 @@ final object Simulator {
     ): Unit
   }
 
+  /** @param phaseTimings Timings of each phase of producing this digest, from elaboration through simulation. Use `svsim.PhaseTiming.summarize` to aggregate timings across many digests.
+    * @param compilationStatistics Statistics about the compiled design, see `svsim.Simulation.compilationStatistics`.
+    */
   final case class BackendInvocationDigest[T](
-    compilationStartTime: Long,
-    compilationEndTime:   Long,
-    outcome:              BackendInvocationOutcome[T]) {
+    compilationStartTime:  Long,
+    compilationEndTime:    Long,
+    outcome:               BackendInvocationOutcome[T],
+    phaseTimings:          Seq[PhaseTiming] = Seq(),
+    compilationStatistics: Seq[(String, Double)] = Seq()) {
     def result = outcome match {
       case SimulationDigest(_, _, outcome) => outcome.get
       case CompilationFailed(error)        => throw error
@@ -36,7 +43,9 @@ final object Simulator {
     workspace:                        Workspace,
     customSimulationWorkingDirectory: Option[String],
     verbose:                          Boolean,
-    body:                             (Simulation.Controller) => U)
+    body:                             (Simulation.Controller) => U,
+    elaborationPhaseTimings:          Seq[PhaseTiming] = Seq(),
+    simulationCache:                  Option[CommonCompilationSettings.SimulationCache] = None)
       extends BackendProcessor {
     val results = scala.collection.mutable.Stack[BackendInvocationDigest[U]]()
 
@@ -48,19 +57,24 @@ final object Simulator {
     ): Unit = {
 
       results.push({
+        val phaseTimings = scala.collection.mutable.ArrayBuffer[PhaseTiming](elaborationPhaseTimings: _*)
         val compilationStartTime = System.nanoTime()
         try {
           val simulation = workspace
             .compile(backend)(
               tag,
-              commonCompilationSettings,
+              // A cache configured explicitly by the simulator takes precedence
+              commonCompilationSettings.copy(
+                simulationCache = commonCompilationSettings.simulationCache.orElse(simulationCache)
+              ),
               backendSpecificCompilationSettings,
               customSimulationWorkingDirectory,
               verbose
             )
           val compilationEndTime = System.nanoTime()
+          phaseTimings ++= simulation.compilationPhaseTimings
           val simulationOutcome = Try {
-            simulation.run(body)
+            simulation.run(reportPhaseTiming = { timing => phaseTimings += timing })(body)
           }
           val simulationEndTime = System.nanoTime()
           BackendInvocationDigest(
@@ -70,14 +84,17 @@ final object Simulator {
               simulationStartTime = compilationEndTime,
               simulationEndTime = simulationEndTime,
               outcome = simulationOutcome
-            )
+            ),
+            phaseTimings = phaseTimings.toSeq,
+            compilationStatistics = simulation.compilationStatistics
           )
         } catch {
           case error: Throwable =>
             BackendInvocationDigest(
               compilationStartTime = compilationStartTime,
               compilationEndTime = System.nanoTime(),
-              outcome = CompilationFailed(error)
+              outcome = CompilationFailed(error),
+              phaseTimings = phaseTimings.toSeq
             )
         }
       })
@@ -125,15 +142,24 @@ trait Simulator {
   def customSimulationWorkingDirectory: Option[String] = None
   def verbose:                          Boolean = false
 
+  /** A cache of artifacts which is used when simulating a `SerializableModuleGenerator`.
+    */
+  def artifactCache: Option[ArtifactCache] = None
+
   private[simulator] def processBackends(processor: Simulator.BackendProcessor): Unit
   private[simulator] def _simulate[T <: RawModule, U](
-    module: => T
-  )(body:   (Simulation.Controller, T) => U
+    module:        => T,
+    cachedSources: Option[(ArtifactCache, String)] = None
+  )(body:          (Simulation.Controller, T) => U
   ): Seq[Simulator.BackendInvocationDigest[U]] = {
+    val elaborationPhaseTimings = scala.collection.mutable.ArrayBuffer[PhaseTiming]()
     val workspace = new Workspace(path = workspacePath, workingDirectoryPrefix = workingDirectoryPrefix)
     workspace.reset()
-    val (dut, ports) = workspace.elaborateGeneratedModuleInternal({ () => module })
-    workspace.generateAdditionalSources()
+    val (dut, ports) =
+      workspace.elaborateGeneratedModuleInternal({ () => module }, elaborationPhaseTimings += _, cachedSources)
+    PhaseTiming.measure("generate-additional-sources", elaborationPhaseTimings += _) {
+      workspace.generateAdditionalSources()
+    }
     val compiler = new Simulator.WorkspaceCompiler(
       workspace,
       customSimulationWorkingDirectory,
@@ -146,11 +172,28 @@ trait Simulator {
           context.completeSimulation()
           outcome
         }
-      }
+      },
+      elaborationPhaseTimings.toSeq,
+      cachedSources.flatMap(_._1.simulationCache)
     )
     processBackends(compiler)
     compiler.results.toSeq
   }
+
+  private[simulator] def _simulateGenerator[M <: RawModule with SerializableModule[P], P <: SerializableModuleParameter, U](
+    generator: SerializableModuleGenerator[M, P]
+  )(body:      (Simulation.Controller, M) => U
+  )(
+    implicit rwP: ReadWriter[P]
+  ): Seq[Simulator.BackendInvocationDigest[U]] = {
+    val cachedSources = artifactCache.map { cache =>
+      val serializedGenerator = upickle.default.write(generator)(
+        SerializableModuleGenerator.rw[P, M](rwP, generator.pTag, generator.mTag)
+      )
+      (cache, cache.sourcesKey(serializedGenerator))
+    }
+    _simulate(generator.module(), cachedSources)(body)
+  }
 }
 
 trait MultiBackendSimulator extends Simulator {
@@ -162,6 +205,17 @@ trait MultiBackendSimulator extends Simulator {
   ): Seq[Simulator.BackendInvocationDigest[U]] = {
     _simulate(module)(body)
   }
+
+  /** Like `simulate`, but reuses artifacts from `artifactCache` (if set) from previous simulations of the same generator.
+    */
+  def simulate[M <: RawModule with SerializableModule[P], P <: SerializableModuleParameter, U](
+    generator: SerializableModuleGenerator[M, P]
+  )(body:      (Simulation.Controller, M) => U
+  )(
+    implicit rwP: ReadWriter[P]
+  ): Seq[Simulator.BackendInvocationDigest[U]] = {
+    _simulateGenerator(generator)(body)
+  }
 }
 
 trait SingleBackendSimulator[T <: Backend] extends Simulator {
@@ -181,4 +235,15 @@ trait SingleBackendSimulator[T <: Backend] extends Simulator {
     _simulate(module)(body).head
   }
 
+  /** Like `simulate`, but reuses artifacts from `artifactCache` (if set) from previous simulations of the same generator.
+    */
+  def simulate[M <: RawModule with SerializableModule[P], P <: SerializableModuleParameter, U](
+    generator: SerializableModuleGenerator[M, P]
+  )(body:      (Simulation.Controller, M) => U
+  )(
+    implicit rwP: ReadWriter[P]
+  ): Simulator.BackendInvocationDigest[U] = {
+    _simulateGenerator(generator)(body).head
+  }
+
 }
@@ -12,47 +12,90 @@ package object simulator {
     }
   }
 
+  /** Times `body` and records the bytes the current thread allocated while it ran, where the JVM supports counting them.
+    *
+    * Allocations are counted per thread, so concurrent measurements do not interfere with each other.
+    */
+  private def measureGenerator[T](name: String, reportPhaseTiming: PhaseTiming => Unit)(body: => T): T = {
+    val allocatedBytes: () => Option[Long] = java.lang.management.ManagementFactory.getThreadMXBean() match {
+      case bean: com.sun.management.ThreadMXBean if bean.isThreadAllocatedMemorySupported() =>
+        val threadId = Thread.currentThread().getId()
+        () => Some(bean.getThreadAllocatedBytes(threadId)).filter(_ >= 0)
+      case _ => () => None
+    }
+    val startAllocatedBytes = allocatedBytes()
+    val startTime = System.nanoTime()
+    val result = body
+    val duration = System.nanoTime() - startTime
+    reportPhaseTiming(
+      PhaseTiming(name, duration, for (start <- startAllocatedBytes; end <- allocatedBytes()) yield end - start)
+    )
+    result
+  }
+
   implicit class ChiselWorkspace(workspace: Workspace) {
     def elaborateGeneratedModule[T <: RawModule](
       generateModule: () => T
     ): T = {
       elaborateGeneratedModuleInternal(generateModule)._1
     }
+    /** @param reportPhaseTiming Called with the timings of running the Chisel generator, and of the complete `ChiselStage` invocation (which additionally includes conversion to FIRRTL and running `firtool`). The generator's timing includes the bytes it allocated.
+      * @param cachedSources A cache and key under which the SystemVerilog emitted for this module is stored. If the cache has an entry for the key, only the generator is run (since the caller needs the elaborated module) and the cached SystemVerilog is used instead of running `firtool`.
+      */
     private[simulator] def elaborateGeneratedModuleInternal[T <: RawModule](
-      generateModule: () => T
+      generateModule:    () => T,
+      reportPhaseTiming: PhaseTiming => Unit = _ => (),
+      cachedSources:     Option[(ArtifactCache, String)] = None
     ): (T, Seq[(Data, ModuleInfo.Port)]) = {
-      // Use CIRCT to generate SystemVerilog sources, and potentially additional artifacts
       var someDut: Option[T] = None
-      val outputAnnotations = (new circt.stage.ChiselStage).execute(
-        Array("--target", "systemverilog", "--split-verilog"),
-        Seq(
-          chisel3.stage.ChiselGeneratorAnnotation { () =>
-            val dut = generateModule()
-            someDut = Some(dut)
-            dut
-          },
-          circt.stage.FirtoolOption("-disable-annotation-unknown"),
-          firrtl.options.TargetDirAnnotation(workspace.supportArtifactsPath)
-        )
-      )
+      val generatorAnnotation = chisel3.stage.ChiselGeneratorAnnotation { () =>
+        val dut = measureGenerator("chisel-stage/elaboration", reportPhaseTiming)(generateModule())
+        someDut = Some(dut)
+        dut
+      }
 
-      // Move the relevant files over to primary-sources
-      val filelist =
-        new java.io.BufferedReader(new java.io.FileReader(s"${workspace.supportArtifactsPath}/filelist.f"))
-      try {
-        filelist.lines().forEach { immutableFilename =>
-          var filename = immutableFilename
-          /// Some files are provided as absolute paths
-          if (filename.startsWith(workspace.supportArtifactsPath)) {
-            filename = filename.substring(workspace.supportArtifactsPath.length + 1)
-          }
-          java.nio.file.Files.move(
-            java.nio.file.Paths.get(s"${workspace.supportArtifactsPath}/$filename"),
-            java.nio.file.Paths.get(s"${workspace.primarySourcesPath}/$filename")
+      val restoredFromCache = cachedSources.exists {
+        case (cache, key) => cache.restoreSources(key, workspace.primarySourcesPath)
+      }
+      if (restoredFromCache) {
+        PhaseTiming.measure("chisel-stage", reportPhaseTiming) {
+          (new chisel3.stage.phases.Elaborate).transform(Seq(generatorAnnotation))
+        }
+      } else {
+        // Use CIRCT to generate SystemVerilog sources, and potentially additional artifacts
+        PhaseTiming.measure("chisel-stage", reportPhaseTiming) {
+          (new circt.stage.ChiselStage).execute(
+            Array("--target", "systemverilog", "--split-verilog"),
+            Seq(
+              generatorAnnotation,
+              circt.stage.FirtoolOption("-disable-annotation-unknown"),
+              firrtl.options.TargetDirAnnotation(workspace.supportArtifactsPath)
+            )
           )
         }
-      } finally {
-        filelist.close()
+
+        // Move the relevant files over to primary-sources
+        val filelist =
+          new java.io.BufferedReader(new java.io.FileReader(s"${workspace.supportArtifactsPath}/filelist.f"))
+        try {
+          filelist.lines().forEach { immutableFilename =>
+            var filename = immutableFilename
+            /// Some files are provided as absolute paths
+            if (filename.startsWith(workspace.supportArtifactsPath)) {
+              filename = filename.substring(workspace.supportArtifactsPath.length + 1)
+            }
+            java.nio.file.Files.move(
+              java.nio.file.Paths.get(s"${workspace.supportArtifactsPath}/$filename"),
+              java.nio.file.Paths.get(s"${workspace.primarySourcesPath}/$filename")
+            )
+          }
+        } finally {
+          filelist.close()
+        }
+
+        cachedSources.foreach {
+          case (cache, key) => cache.storeSources(key, workspace.primarySourcesPath)
+        }
       }
 
       // Initialize Module Info
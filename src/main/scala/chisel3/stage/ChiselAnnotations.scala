@@ -105,6 +105,79 @@ object SourceRootAnnotation extends HasShellOptions {
   )
 }
 
+/** The number of threads on which independent Definitions may be elaborated concurrently, see
+  * `chisel3.experimental.hierarchy.Definition.concurrently`
+  *
+  * Concurrent elaboration produces exactly the same circuit as serial elaboration, but the generators of the
+  * Definitions must not share mutable state.
+  */
+case class DefinitionThreadsAnnotation(threads: Int) extends NoTargetAnnotation with Unserializable with ChiselOption
+
+object DefinitionThreadsAnnotation extends HasShellOptions {
+  val options = Seq(
+    new ShellOption[Int](
+      longOption = "definition-threads",
+      toAnnotationSeq = { threads =>
+        if (threads < 1) {
+          throw new OptionsException(s"Must be at least one thread, but was $threads!")
+        }
+        Seq(DefinitionThreadsAnnotation(threads))
+      },
+      helpText = "Elaborate independent Definitions concurrently on this many threads (default: 1)",
+      helpValueName = Some("<threads>")
+    )
+  )
+}
+
+/** Profiles the elaboration of each module, writing the profile to a file
+  *
+  * For each module class and desired name (which usually reflects the parameterization of the module), the profile
+  * records the wall time spent and the bytes allocated elaborating them, and the number of commands and objects with
+  * ids they contain. If the file name ends in `.json`, the elaboration of each module is written as an event in the
+  * Trace Event Format, which can be viewed with tools such as `chrome://tracing` or Perfetto. Otherwise, a
+  * tab-separated report is written, sorted by wall time.
+  *
+  * @param file the file to write the profile to, relative to the target directory unless it is absolute
+  */
+case class ElaborationProfileAnnotation(file: String) extends NoTargetAnnotation with Unserializable with ChiselOption
+
+object ElaborationProfileAnnotation extends HasShellOptions {
+  val options = Seq(
+    new ShellOption[String](
+      longOption = "elaboration-profile",
+      toAnnotationSeq = file => Seq(ElaborationProfileAnnotation(file)),
+      helpText =
+        "Profile elaboration, writing a report (or trace events, for a .json file) to a file in the target directory",
+      helpValueName = Some("<file>")
+    )
+  )
+}
+
+/** Lowers printfs to binary records, which are formatted after simulation, writing their formats to a file
+  *
+  * Formatting the message of a printf in simulation, with Verilog's `fwrite` task, can dominate the run time of a
+  * design which prints on every cycle. Instead, each printf calls DPI functions which append its id and the raw values
+  * of its arguments to a buffer, as binary records. The format of each printf is written to the file as JSON at the
+  * end of elaboration, and [[chisel3.simulator.BinaryPrintfDecoder]] uses it to format the records. Simulations run by
+  * svsim write the records to `binary-printf.bin` in their working directory, if there are any.
+  *
+  * Only printfs are lowered, not the messages of assertions. The width of each printf argument must be known.
+  *
+  * @param file the file to write the formats of the printfs to, relative to the target directory unless it is absolute
+  */
+case class BinaryPrintfAnnotation(file: String) extends NoTargetAnnotation with Unserializable with ChiselOption
+
+object BinaryPrintfAnnotation extends HasShellOptions {
+  val options = Seq(
+    new ShellOption[String](
+      longOption = "binary-printf",
+      toAnnotationSeq = file => Seq(BinaryPrintfAnnotation(file)),
+      helpText = "Lower printfs to binary records, writing their formats to a file in the target directory",
+      helpValueName = Some("<file>")
+    )
+  )
+}
+
 /** An [[firrtl.annotations.Annotation]] storing a function that returns a Chisel module
   * @param gen a generator function
   */
@@ -173,6 +246,14 @@ object CircuitSerializationAnnotation {
   case object FirrtlFileFormat extends Format {
     def extension = ".fir"
   }
+
+  /** Emit a FIRRTL circuit including annotations, as `firrtl.ir.Serializer.lazily` would
+    *
+    * Circuits produced by [[chisel3.stage.phases.Convert]] are emitted directly from the Chisel IR, without first
+    * converting each module to FIRRTL IR.
+    */
+  def emitLazily(circuit: firrtl.ir.Circuit, annos: Seq[Annotation]): Iterable[String] =
+    chisel3.internal.firrtl.Serializer.lazily(circuit, annos)
 }
 
 import CircuitSerializationAnnotation._
@@ -220,9 +301,8 @@ case class CircuitSerializationAnnotation(circuit: Circuit, filename: String, fo
       val withAnnos = CircuitWithAnnos(converted, annos)
       Serializer.lazily(withAnnos)
     }
-    val modules = circuit.components.iterator.map(Converter.convert)
-    val moduleStrings = modules.flatMap { m =>
-      Serializer.lazily(m, 1) ++ Seq("\n\n")
+    val moduleStrings = circuit.components.iterator.flatMap { c =>
+      chisel3.internal.firrtl.Serializer.lazily(c) ++ Seq("\n\n")
     }
     prelude ++ moduleStrings
   }
@@ -11,7 +11,10 @@ class ChiselOptions private[stage] (
   val warningsAsErrors:    Boolean = false,
   val outputFile:          Option[String] = None,
   val chiselCircuit:       Option[Circuit] = None,
-  val sourceRoots:         Vector[File] = Vector.empty) {
+  val sourceRoots:         Vector[File] = Vector.empty,
+  val definitionThreads:   Int = 1,
+  val elaborationProfile:  Option[String] = None,
+  val binaryPrintf:        Option[String] = None) {
 
   private[stage] def copy(
     printFullStackTrace: Boolean = printFullStackTrace,
@@ -19,7 +22,10 @@ class ChiselOptions private[stage] (
     warningsAsErrors:    Boolean = warningsAsErrors,
     outputFile:          Option[String] = outputFile,
     chiselCircuit:       Option[Circuit] = chiselCircuit,
-    sourceRoots:         Vector[File] = sourceRoots
+    sourceRoots:         Vector[File] = sourceRoots,
+    definitionThreads:   Int = definitionThreads,
+    elaborationProfile:  Option[String] = elaborationProfile,
+    binaryPrintf:        Option[String] = binaryPrintf
   ): ChiselOptions = {
 
     new ChiselOptions(
@@ -28,7 +34,10 @@ class ChiselOptions private[stage] (
       warningsAsErrors = warningsAsErrors,
       outputFile = outputFile,
       chiselCircuit = chiselCircuit,
-      sourceRoots = sourceRoots
+      sourceRoots = sourceRoots,
+      definitionThreads = definitionThreads,
+      elaborationProfile = elaborationProfile,
+      binaryPrintf = binaryPrintf
     )
 
   }
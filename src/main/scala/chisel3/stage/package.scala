@@ -20,12 +20,15 @@ package object stage {
     def view(options: AnnotationSeq): ChiselOptions = options.collect { case a: ChiselOption => a }
       .foldLeft(new ChiselOptions()) { (c, x) =>
         x match {
-          case PrintFullStackTraceAnnotation => c.copy(printFullStackTrace = true)
-          case ThrowOnFirstErrorAnnotation   => c.copy(throwOnFirstError = true)
-          case WarningsAsErrorsAnnotation    => c.copy(warningsAsErrors = true)
-          case ChiselOutputFileAnnotation(f) => c.copy(outputFile = Some(f))
-          case ChiselCircuitAnnotation(a)    => c.copy(chiselCircuit = Some(a))
-          case SourceRootAnnotation(s)       => c.copy(sourceRoots = c.sourceRoots :+ s)
+          case PrintFullStackTraceAnnotation   => c.copy(printFullStackTrace = true)
+          case ThrowOnFirstErrorAnnotation     => c.copy(throwOnFirstError = true)
+          case WarningsAsErrorsAnnotation      => c.copy(warningsAsErrors = true)
+          case ChiselOutputFileAnnotation(f)   => c.copy(outputFile = Some(f))
+          case ChiselCircuitAnnotation(a)      => c.copy(chiselCircuit = Some(a))
+          case SourceRootAnnotation(s)         => c.copy(sourceRoots = c.sourceRoots :+ s)
+          case DefinitionThreadsAnnotation(n)  => c.copy(definitionThreads = n)
+          case ElaborationProfileAnnotation(f) => c.copy(elaborationProfile = Some(f))
+          case BinaryPrintfAnnotation(f)       => c.copy(binaryPrintf = Some(f))
         }
       }
 
@@ -11,7 +11,9 @@ import firrtl.stage.FirrtlCircuitAnnotation
 import scala.annotation.nowarn
 
 /** This prepares a `ChiselCircuitAnnotation for compilation with FIRRTL. This does three things:
-  *   - Uses `chisel3.internal.firrtl.Converter` to generate a FirrtlCircuitAnnotation`
+  *   - Uses `chisel3.internal.firrtl.Converter` to generate a FirrtlCircuitAnnotation`. Modules are converted lazily,
+  *     when they are first accessed, and kept once converted, so the FIRRTL IR of modules which nothing traverses
+  *     (for instance, when the circuit is serialized directly from the Chisel IR) is never built.
   *   - Extracts all `firrtl.annotations.Annotation`s from the `chisel3.internal.firrtl.Circuit`
   *   - Generates any needed `RunFirrtlTransformAnnotation`s from extracted `firrtl.annotations.Annotation`s
   */
@@ -27,7 +29,7 @@ class Convert extends Phase {
     case a: ChiselCircuitAnnotation =>
       Some(a) ++
         /* Convert this Chisel Circuit to a FIRRTL Circuit */
-        Some(FirrtlCircuitAnnotation(Converter.convert(a.circuit))) ++
+        Some(FirrtlCircuitAnnotation(Converter.convertLazily(a.circuit))) ++
         /* Convert all Chisel Annotations to FIRRTL Annotations */
         //TODO: clean up this code when firrtl is merged
         a.circuit.firrtlAnnotations
@@ -4,7 +4,7 @@ package chisel3.stage.phases
 
 import chisel3.Module
 import chisel3.internal.ExceptionHelpers.ThrowableHelpers
-import chisel3.internal.{Builder, DynamicContext}
+import chisel3.internal.{BinaryPrintf, Builder, DynamicContext, ElaborationProfiler}
 import chisel3.stage.{
   ChiselCircuitAnnotation,
   ChiselGeneratorAnnotation,
@@ -13,9 +13,12 @@ import chisel3.stage.{
   ThrowOnFirstErrorAnnotation
 }
 import firrtl.AnnotationSeq
-import firrtl.options.Phase
+import firrtl.options.{Phase, StageOptions}
 import firrtl.options.Viewer.view
 
+import java.nio.charset.StandardCharsets
+import java.nio.file.{Files, Paths}
+
 /** Elaborate all [[chisel3.stage.ChiselGeneratorAnnotation]]s into [[chisel3.stage.ChiselCircuitAnnotation]]s.
   */
 class Elaborate extends Phase {
@@ -34,10 +37,30 @@ class Elaborate extends Phase {
             annotations,
             chiselOptions.throwOnFirstError,
             chiselOptions.warningsAsErrors,
-            chiselOptions.sourceRoots
+            chiselOptions.sourceRoots,
+            chiselOptions.definitionThreads
           )
-        val (circuit, dut) =
-          Builder.build(Module(gen()), context)
+        context.profiler = chiselOptions.elaborationProfile.map(_ => new ElaborationProfiler)
+        context.binaryPrintf = chiselOptions.binaryPrintf.isDefined
+        val (elaborated, dut) =
+          try {
+            Builder.build(Module(gen()), context)
+          } finally {
+            // The profile is written even if elaboration fails, since it may show why
+            for (file <- chiselOptions.elaborationProfile; profiler <- context.profiler) {
+              val profile = if (file.endsWith(".json")) profiler.traceEvents else profiler.report
+              val path = Paths.get(view[StageOptions](annotations).getBuildFileName(file))
+              Files.write(path, profile.getBytes(StandardCharsets.UTF_8))
+            }
+          }
+        val circuit = chiselOptions.binaryPrintf match {
+          case Some(file) =>
+            val (circuit, table) = BinaryPrintf.number(elaborated)
+            val path = Paths.get(view[StageOptions](annotations).getBuildFileName(file))
+            Files.write(path, table.toJson.getBytes(StandardCharsets.UTF_8))
+            circuit
+          case None => elaborated
+        }
         Seq(ChiselCircuitAnnotation(circuit), DesignAnnotation(dut))
       } catch {
         /* if any throwable comes back and we're in "stack trace trimming" mode, then print an error and trim the stack trace
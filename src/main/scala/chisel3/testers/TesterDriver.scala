@@ -5,11 +5,12 @@ package chisel3.testers
 import chisel3._
 import chisel3.stage.phases.{Convert, Elaborate, Emitter, MaybeInjectingPhase}
 import chisel3.stage.{ChiselCircuitAnnotation, ChiselGeneratorAnnotation}
-import firrtl.AnnotationSeq
+import firrtl.{AnnotationSeq, EmittedVerilogCircuitAnnotation}
 import firrtl.annotations.NoTargetAnnotation
 import firrtl.options.{Dependency, Phase, PhaseManager, TargetDirAnnotation, Unserializable}
 import firrtl.stage.FirrtlCircuitAnnotation
 import firrtl.transforms.BlackBoxSourceHelper.writeResourceToDirectory
+import svsim.PhaseTiming
 
 import java.io._
 import scala.annotation.nowarn
@@ -29,6 +30,10 @@ object TesterDriver extends BackendCompilationUtilities {
       processLogger:        ProcessLogger = loggingProcessLogger
     ): Boolean
   }
+  /** Called with the timing of each stage of `execute` (elaboration, `firtool`, Verilator, C++ compilation and running the test), for instance to track build-time regressions.
+    */
+  case class PhaseTimingReporter(report: PhaseTiming => Unit) extends NoTargetAnnotation with Unserializable
+
   case object VerilatorBackend extends Backend {
     def ensureExistingAbsolutePath(name: String): os.Path = {
       val otherPath: os.Path =
@@ -57,6 +62,9 @@ object TesterDriver extends BackendCompilationUtilities {
       nameHint:             Option[String] = None,
       processLogger:        ProcessLogger = loggingProcessLogger
     ): Boolean = {
+      val reportPhaseTiming: PhaseTiming => Unit =
+        annotations.collectFirst { case PhaseTimingReporter(report) => report }.getOrElse((_: PhaseTiming) => ())
+
       val pm = new PhaseManager(
         targets = Seq(
           Dependency[AddImplicitTesterDirectory],
@@ -66,7 +74,9 @@ object TesterDriver extends BackendCompilationUtilities {
         )
       )
 
-      val annotationsFromPhase1 = pm.transform(ChiselGeneratorAnnotation(finishWrapper(t)) +: annotations)
+      val annotationsFromPhase1 = PhaseTiming.measure("elaboration", reportPhaseTiming) {
+        pm.transform(ChiselGeneratorAnnotation(finishWrapper(t)) +: annotations)
+      }
 
       val target: String = annotationsFromPhase1.collectFirst { case FirrtlCircuitAnnotation(cir) => cir.main }.get
       val path = annotationsFromPhase1.collectFirst { case TargetDirAnnotation(dir) => dir }.map(new File(_)).get
@@ -83,15 +93,35 @@ object TesterDriver extends BackendCompilationUtilities {
       })
 
       val dirName = annotationsFromPhase1.collectFirst { case TargetDirAnnotation(dirName) => dirName }.getOrElse(".")
-      val verilog = circt.stage.ChiselStage.emitSystemVerilog(t())
+      // The circuit converted (and possibly injected into) above is compiled, so that this only measures firtool
+      val circuit = annotationsFromPhase1.collectFirst { case a: FirrtlCircuitAnnotation => a }.get
+      val compile = new PhaseManager(
+        targets = Seq(
+          Dependency[circt.stage.phases.AddImplicitOutputFile],
+          Dependency[circt.stage.phases.Checks],
+          Dependency[circt.stage.phases.CIRCT]
+        )
+      )
+      val verilog = PhaseTiming.measure("chisel-stage", reportPhaseTiming) {
+        compile
+          .transform(Seq(circuit, circt.stage.CIRCTTargetAnnotation(circt.stage.CIRCTTarget.SystemVerilog)))
+          .collectFirst { case EmittedVerilogCircuitAnnotation(a) => a }
+          .get
+          .value
+      }
       val verilogPath = ensureExistingAbsolutePath(path.toString) / (target + ".v")
       os.write.over(verilogPath, verilog)
       // Use sys.Process to invoke a bunch of backend stuff, then run the resulting exe
-      if (
-        (verilogToCpp(target, path, additionalVFiles, cppHarness) #&&
-          cppToExe(target, path)).!(processLogger) == 0
-      ) {
-        executeExpectingSuccess(target, path)
+      // Verilator and the C++ build are run separately (rather than as a single `#&&` process) so that they can be timed separately
+      val built = PhaseTiming.measure("verilator", reportPhaseTiming) {
+        verilogToCpp(target, path, additionalVFiles, cppHarness).!(processLogger) == 0
+      } && PhaseTiming.measure("cxx-build", reportPhaseTiming) {
+        cppToExe(target, path).!(processLogger) == 0
+      }
+      if (built) {
+        PhaseTiming.measure("simulation", reportPhaseTiming) {
+          executeExpectingSuccess(target, path)
+        }
       } else {
         false
       }
@@ -0,0 +1,399 @@
+// SPDX-License-Identifier: Apache-2.0
+
+package chisel3.util.experimental.decode
+
+import chisel3.util.BitPat
+
+import java.util.{Arrays, Comparator, HashMap => JHashMap}
+import java.util.function.IntFunction
+import java.util.stream.IntStream
+import scala.collection.JavaConverters._
+import scala.collection.mutable
+
+/** A [[Minimizer]] implementation of the same Quine-Mccluskey algorithm as [[QMCMinimizer]], which always produces the
+  * same result, but is much faster for tables with many entries or wide inputs.
+  *
+  * Implicants are packed into words of `Long`s instead of [[BitPat]]s, so that checking whether they intersect or
+  * cover each other is a few bitwise operations per word. Implicants are bucketed by the number of don't cares and of
+  * ones, as in [[QMCMinimizer]], but the implicants that an implicant can be merged with are looked up by their value,
+  * instead of being searched for. Coverage of minterms by prime implicants is computed once, as bit sets. Every output
+  * bit is minimized independently, and in parallel.
+  */
+object BitParallelQMCMinimizer extends Minimizer {
+
+  /** An implicant whose value and mask are packed into words, least significant first */
+  private final class Implicant(val value: Array[Long], val mask: Array[Long]) {
+    var isPrime: Boolean = true
+
+    override def equals(that: Any): Boolean = that match {
+      case x: Implicant => Arrays.equals(value, x.value) && Arrays.equals(mask, x.mask)
+      case _ => false
+    }
+
+    override val hashCode: Int = 31 * Arrays.hashCode(value) + Arrays.hashCode(mask)
+
+    /** The number of comparators needed to implement this implicant, see [[QMCMinimizer]] */
+    def cost: Int = bitCount(mask)
+  }
+
+  private def pack(x: BigInt, words: Int): Array[Long] = Array.tabulate(words)(i => (x >> (64 * i)).toLong)
+
+  private def unpack(x: Array[Long]): BigInt = x.foldRight(BigInt(0)) { (word, acc) =>
+    (acc << 64) | (BigInt(word >>> 32) << 32) | (word & 0xffffffffL)
+  }
+
+  private def bitCount(x: Array[Long]): Int = {
+    var count = 0
+    for (word <- x) count += java.lang.Long.bitCount(word)
+    count
+  }
+
+  private def testBit(x: Array[Long], bit: Int): Boolean =
+    bit < 64 * x.length && (x(bit >>> 6) & (1L << bit)) != 0
+
+  private def setBit(x: Array[Long], bit: Int): Array[Long] = {
+    val result = x.clone()
+    result(bit >>> 6) |= 1L << bit
+    result
+  }
+
+  private def clearBit(x: Array[Long], bit: Int): Array[Long] = {
+    val result = x.clone()
+    result(bit >>> 6) &= ~(1L << bit)
+    result
+  }
+
+  /** Whether two implicants have the same value on all of the bits that both care about */
+  private def intersects(xValue: Array[Long], xMask: Array[Long], y: Implicant): Boolean = {
+    var i = 0
+    while (i < xValue.length) {
+      if (((xValue(i) ^ y.value(i)) & xMask(i) & y.mask(i)) != 0) return false
+      i += 1
+    }
+    true
+  }
+
+  /** Whether `x` covers `y`, see [[QMCMinimizer]] */
+  private def covers(x: Implicant, y: Implicant): Boolean = {
+    var i = 0
+    while (i < x.value.length) {
+      if (((x.value(i) ^ y.value(i)) & x.mask(i) | ~y.mask(i) & x.mask(i)) != 0) return false
+      i += 1
+    }
+    true
+  }
+
+  /** The order of implicants of [[QMCMinimizer]]: by value, then by mask, descending */
+  private val ordering: Comparator[Implicant] = new Comparator[Implicant] {
+    private def compareValues(x: Array[Long], y: Array[Long]): Int = {
+      var i = x.length - 1
+      while (i >= 0) {
+        val c = java.lang.Long.compareUnsigned(x(i), y(i))
+        if (c != 0) return c
+        i -= 1
+      }
+      0
+    }
+    def compare(x: Implicant, y: Implicant): Int = {
+      val c = compareValues(x.value, y.value)
+      if (c != 0) c else compareValues(y.mask, x.mask)
+    }
+  }
+
+  /** Bit sets of minterm indices */
+  private object BitSets {
+    def empty(size: Int): Array[Long] = new Array[Long]((size + 63) / 64)
+    def contains(x: Array[Long], i: Int): Boolean = (x(i >>> 6) & (1L << i)) != 0
+    def add(x: Array[Long], i: Int): Unit = x(i >>> 6) |= 1L << i
+    def and(x: Array[Long], y: Array[Long]): Array[Long] = Array.tabulate(x.length)(i => x(i) & y(i))
+    def andNot(x: Array[Long], y: Array[Long]): Array[Long] = Array.tabulate(x.length)(i => x(i) & ~y(i))
+    def isEmpty(x: Array[Long]): Boolean = x.forall(_ == 0)
+    def size(x: Array[Long]): Int = bitCount(x)
+    def subsetOf(x: Array[Long], y: Array[Long]): Boolean = x.indices.forall(i => (x(i) & ~y(i)) == 0)
+    def elements(x: Array[Long]): Seq[Int] = (0 until 64 * x.length).filter(contains(x, _))
+  }
+
+  /** Calculate essential prime implicants, as `getEssentialPrimeImplicants` of [[QMCMinimizer]].
+    *
+    * @param primes  Indices of prime implicants, in order
+    * @param active  Bit set of the minterms to cover
+    * @param covered Bit sets of the minterms that each prime implicant covers
+    * @return (a, b, c)
+    *         a: indices of essential prime implicants
+    *         b: indices of nonessential prime implicants
+    *         c: bit set of minterms that are not covered by any of the essential prime implicants
+    */
+  private def getEssentialPrimeImplicants(
+    primes:  Seq[Int],
+    active:  Array[Long],
+    covered: Array[Array[Long]]
+  ): (Seq[Int], Seq[Int], Array[Long]) = {
+    // eliminate prime implicants that can be covered by other prime implicants
+    // QMCMinimizer starts over after every elimination, but as coverage does not depend on the other prime
+    // implicants, scanning on from the eliminated one finds the same prime implicants to eliminate.
+    val remaining = mutable.ArrayBuffer(primes: _*)
+    val primeCovers = mutable.ArrayBuffer(primes.map(p => BitSets.and(covered(p), active)): _*)
+    val sizes = mutable.ArrayBuffer(primeCovers.map(BitSets.size): _*)
+    var i = 0
+    while (i < remaining.length) {
+      var j = i + 1
+      while (j < remaining.length) {
+        // we prefer prime implicants with wider implicants coverage
+        if (sizes(i) > sizes(j) && BitSets.subsetOf(primeCovers(j), primeCovers(i))) {
+          remaining.remove(j)
+          primeCovers.remove(j)
+          sizes.remove(j)
+        } else {
+          j += 1
+        }
+      }
+      i += 1
+    }
+
+    // implicants that only one prime implicant covers
+    val once = BitSets.empty(64 * active.length)
+    val twice = BitSets.empty(64 * active.length)
+    for (cover <- primeCovers; w <- cover.indices) {
+      twice(w) |= once(w) & cover(w)
+      once(w) |= cover(w)
+    }
+    val essentiallyCovered = BitSets.andNot(once, twice)
+    // essential prime implicants, prime implicants that covers only one implicant
+    val isEssential = primeCovers.map(cover => !BitSets.isEmpty(BitSets.and(cover, essentiallyCovered)))
+    val essential = remaining.indices.filter(isEssential).map(remaining)
+    val nonessential = remaining.indices.filterNot(isEssential).map(remaining)
+    // implicants that no essential prime implicants covers
+    val essentialCover = BitSets.empty(64 * active.length)
+    for (k <- remaining.indices if isEssential(k); w <- active.indices) essentialCover(w) |= primeCovers(k)(w)
+    val uncovered = BitSets.andNot(active, essentialCover)
+    if (essential.isEmpty || BitSets.isEmpty(uncovered))
+      (essential, nonessential, uncovered)
+    else {
+      val (a, b, c) = getEssentialPrimeImplicants(nonessential, uncovered, covered)
+      (essential ++ a, b, c)
+    }
+  }
+
+  /** Select nonessential prime implicants that cover all of `minterms` with Petrick's method, as `getCover` of
+    * [[QMCMinimizer]].
+    *
+    * Instead of enumerating every combination, combinations are built up one minterm at a time and abandoned once they
+    * cost more than the cheapest complete one. A minterm which is already covered by the combination so far adds no
+    * implicant to it, which can only make it cheaper, unless an implicant costs nothing.
+    *
+    * @param primes     Prime implicants, in order
+    * @param implicants Indices of nonessential prime implicants
+    * @param minterms   Indices of minterms that are not covered by essential prime implicants
+    * @param covered    Bit sets of the minterms that each prime implicant covers
+    * @return Indices of the selected prime implicants
+    */
+  private def getCover(
+    primes:     Array[Implicant],
+    implicants: Seq[Int],
+    minterms:   Seq[Int],
+    covered:    Array[Array[Long]]
+  ): Seq[Int] = {
+    // cover(i): nonessential prime implicants that covers `minterms(i)`
+    val cover = minterms.map(m => implicants.filter(p => BitSets.contains(covered(p), m)).toArray).toArray
+    val skipCovered = implicants.forall(primes(_).cost > 0)
+
+    // Prime implicants are sorted, so comparing their indices compares them
+    def cheaper(a: Array[Int], costA: Int, b: Array[Int], costB: Int): Boolean =
+      costA < costB || costA == costB && {
+        var i = 0
+        while (i < a.length && i < b.length && a(i) == b(i)) i += 1
+        i < b.length && (i == a.length || a(i) < b(i))
+      }
+
+    var best: Array[Int] = null
+    var bestCost = Int.MaxValue
+    val chosen = mutable.SortedSet.empty[Int]
+    def search(i: Int, cost: Int): Unit =
+      if (cost <= bestCost) {
+        if (i == cover.length) {
+          val candidate = chosen.toArray
+          if (best == null || cheaper(candidate, cost, best, bestCost)) {
+            best = candidate
+            bestCost = cost
+          }
+        } else if (skipCovered && chosen.exists(p => BitSets.contains(covered(p), minterms(i)))) {
+          search(i + 1, cost)
+        } else {
+          for (p <- cover(i)) {
+            if (chosen.add(p)) {
+              search(i + 1, cost + primes(p).cost)
+              chosen.remove(p)
+            } else {
+              search(i + 1, cost)
+            }
+          }
+        }
+      }
+
+    if (minterms.nonEmpty) {
+      search(0, 0)
+      best.toSeq
+    } else
+      Seq[Int]()
+  }
+
+  /** Minimize output bit `i`, as [[QMCMinimizer]] does
+    *
+    * @return the input [[BitPat]]s for which output bit `i` is `1`
+    */
+  private def minimizeOutput(
+    default:     BitPat,
+    outputs:     IndexedSeq[BitPat],
+    n:           Int,
+    inputValues: IndexedSeq[Array[Long]],
+    inputMasks:  IndexedSeq[Array[Long]],
+    i:           Int
+  ): Seq[BitPat] = {
+    def implicantsWhere(f: BitPat => Boolean): IndexedSeq[Implicant] =
+      outputs.indices.collect {
+        case k if f(outputs(k)) => new Implicant(inputValues(k), inputMasks(k))
+      }
+    // Minterms, implicants that makes the output to be 1
+    val mint = implicantsWhere(t => t.mask.testBit(i) && t.value.testBit(i))
+    // Maxterms, implicants that makes the output to be 0
+    val maxt = implicantsWhere(t => t.mask.testBit(i) && !t.value.testBit(i))
+    // Don't cares, implicants that can produce either 0 or 1 as output
+    val dc = implicantsWhere(t => !t.mask.testBit(i))
+
+    val (implicants, defaultToDc) =
+      if (!default.mask.testBit(i)) (mint, true) // default to ?
+      else if (!default.value.testBit(i)) (mint ++ dc, false) // default to 0
+      else (maxt ++ dc, false) // default to 1
+
+    // mergeTable(i)(j): implicants with i don't cares and j ones, each mapped to itself
+    val mergeTable = Array.fill(n + 1, n + 1)(new JHashMap[Implicant, Implicant])
+    def add(level: Int, ones: Int, x: Implicant): Unit = mergeTable(level)(ones).putIfAbsent(x, x)
+    for (x <- implicants) {
+      val level = n - bitCount(x.mask)
+      val ones = bitCount(x.value)
+      if (level >= 0 && level <= n && ones <= n) add(level, ones, x)
+    }
+
+    for (i <- 0 to n) {
+      for (j <- 0 until n - i) {
+        val upper = mergeTable(i)(j + 1)
+        if (!upper.isEmpty) {
+          for (a <- mergeTable(i)(j).values.asScala; bit <- 0 until n if !testBit(a.value, bit)) {
+            // the only implicants similar to `a` have the same mask and one more one
+            val x = upper.get(new Implicant(setBit(a.value, bit), a.mask))
+            if (x != null) {
+              x.isPrime = false
+              a.isPrime = false
+              add(i + 1, j, new Implicant(a.value, clearBit(a.mask, bit)))
+            }
+          }
+        }
+      }
+      if (defaultToDc) {
+        for (j <- 0 until n - i) {
+          for (a <- mergeTable(i)(j).values.asScala if a.isPrime) {
+            if (testBit(a.mask, i) && !testBit(a.value, i)) {
+              // this bit is `0`
+              if (!maxt.exists(intersects(setBit(a.value, i), a.mask, _))) {
+                a.isPrime = false
+                add(i + 1, j, new Implicant(a.value, clearBit(a.mask, i)))
+              }
+            }
+          }
+          for (a <- mergeTable(i)(j + 1).values.asScala if a.isPrime) {
+            if (testBit(a.mask, i) && testBit(a.value, i)) {
+              // this bit is `1`
+              if (!maxt.exists(intersects(clearBit(a.value, i), a.mask, _))) {
+                a.isPrime = false
+                add(i + 1, j, new Implicant(clearBit(a.value, i), clearBit(a.mask, i)))
+              }
+            }
+          }
+        }
+      }
+    }
+
+    val primes = mergeTable.flatten.flatMap(_.values.asScala).filter(_.isPrime)
+    Arrays.sort(primes, ordering)
+
+    // covered(p): bit set of the implicants that `primes(p)` covers
+    val covered = primes.map { p =>
+      val cover = BitSets.empty(implicants.length)
+      for (m <- implicants.indices if covers(p, implicants(m))) BitSets.add(cover, m)
+      cover
+    }
+    val all = BitSets.empty(implicants.length)
+    implicants.indices.foreach(BitSets.add(all, _))
+
+    val (essentialPrimeImplicants, nonessentialPrimeImplicants, uncoveredImplicants) =
+      getEssentialPrimeImplicants(primes.indices, all, covered)
+
+    (essentialPrimeImplicants ++ getCover(
+      primes,
+      nonessentialPrimeImplicants,
+      BitSets.elements(uncoveredImplicants),
+      covered
+    )).map { p =>
+      new BitPat(unpack(primes(p).value), unpack(primes(p).mask), n)
+    }
+  }
+
+  def minimize(table: TruthTable): TruthTable = {
+    require(table.table.nonEmpty, "Truth table must not be empty")
+
+    // extract decode table to inputs and outputs
+    val (inputs, outputs) = table.table.toIndexedSeq.unzip
+
+    require(
+      outputs.map(_.getWidth == table.default.getWidth).reduce(_ && _),
+      "All output BitPats and default BitPat must have the same length"
+    )
+    require(
+      if (inputs.toSeq.length > 1) inputs.tail.map(_.width == inputs.head.width).reduce(_ && _) else true,
+      "All input BitPats must have the same length"
+    )
+
+    // number of inputs
+    val n = inputs.head.width
+    // number of outputs
+    val m = outputs.head.getWidth
+
+    val words = (n + 63) / 64
+    val inputValues = inputs.map(x => pack(x.value, words))
+    val inputMasks = inputs.map(x => pack(x.mask, words))
+
+    // make sure no two inputs specified in the truth table intersect
+    for (k <- inputs.indices; l <- k + 1 until inputs.length)
+      require(
+        !intersects(inputValues(k), inputMasks(k), new Implicant(inputValues(l), inputMasks(l))),
+        "truth table entries " + inputs(k) + " and " + inputs(l) + " overlap"
+      )
+
+    // for all outputs
+    val minimized = IntStream
+      .range(0, m)
+      .parallel()
+      .mapToObj(new IntFunction[Seq[BitPat]] {
+        def apply(i: Int): Seq[BitPat] = minimizeOutput(table.default, outputs, n, inputValues, inputMasks, i)
+      })
+      .toArray
+
+    // the outputs of each input which is selected for any output bit, which are '1' where selected and '?' otherwise
+    val rows = mutable.LinkedHashMap[BitPat, BigInt]()
+    for (i <- 0 until m; input <- minimized(i).asInstanceOf[Seq[BitPat]])
+      rows(input) = rows.getOrElse(input, BigInt(0)).setBit(i)
+
+    // special case for 0 and DontCare, if output is not couple to input
+    if (rows.isEmpty)
+      table.copy(
+        Seq(
+          (
+            BitPat(s"b${"?" * table.inputWidth}"),
+            BitPat(s"b${"0" * table.outputWidth}")
+          )
+        )
+      )
+    else
+      table.copy(table = rows.toSeq.map { case (input, output) => input -> new BitPat(output, output, m) })
+  }
+}
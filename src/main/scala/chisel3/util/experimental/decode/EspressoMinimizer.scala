@@ -5,6 +5,12 @@ package chisel3.util.experimental.decode
 import chisel3.util.BitPat
 import logger.LazyLogging
 
+import java.io.File
+import java.nio.charset.StandardCharsets
+import java.nio.file.{Files, StandardCopyOption}
+import java.security.MessageDigest
+import java.util.concurrent.{Callable, ExecutionException, Executors, ThreadFactory}
+
 case object EspressoNotFoundException extends Exception
 
 /** A [[Minimizer]] implementation to use espresso to minimize the [[TruthTable]].
@@ -16,12 +22,76 @@ case object EspressoNotFoundException extends Exception
   * a espresso executable should be downloaded from [[https://github.com/chipsalliance/espresso]]
   *
   * If user want to user the this [[Minimizer]], a espresso executable should be added to system PATH environment.
+  *
+  * The tables which espresso is run on (one for each kind of default output bit, see `TruthTable.split`) are
+  * minimized concurrently. espresso's output is cached in the directory given by the `CHISEL_ESPRESSO_CACHE`
+  * environment variable, if it is set, or in the directory given to [[cachedIn]].
   */
 object EspressoMinimizer extends Minimizer with LazyLogging {
-  def minimize(table: TruthTable): TruthTable =
-    TruthTable.merge(TruthTable.split(table).map { case (table, indexes) => (espresso(table), indexes) })
+  def minimize(table: TruthTable): TruthTable = minimize(table, environmentCacheDirectory)
+
+  /** Returns a [[Minimizer]] which caches espresso's output in `directory`, keyed by its input and the espresso
+    * executable, so that unchanged tables are not minimized again. The directory may be shared by concurrent
+    * processes.
+    */
+  def cachedIn(directory: File): Minimizer = new Minimizer {
+    def minimize(table: TruthTable): TruthTable = EspressoMinimizer.minimize(table, Some(directory))
+  }
+
+  private lazy val environmentCacheDirectory = sys.env.get("CHISEL_ESPRESSO_CACHE").map(new File(_))
+
+  private def minimize(table: TruthTable, cacheDirectory: Option[File]): TruthTable = {
+    val split = TruthTable.split(table)
+    val minimized = concurrently(split.map(_._1))(espresso(_, cacheDirectory))
+    TruthTable.merge(minimized.zip(split).map { case (table, (_, indexes)) => (table, indexes) })
+  }
+
+  // Shared by every minimization, since a table splits into at most three sub-tables
+  private lazy val executor = Executors.newFixedThreadPool(
+    Runtime.getRuntime().availableProcessors(),
+    new ThreadFactory {
+      def newThread(runnable: Runnable): Thread = {
+        val thread = new Thread(runnable, "chisel-espresso")
+        thread.setDaemon(true)
+        thread
+      }
+    }
+  )
 
-  private def espresso(table: TruthTable): TruthTable = {
+  /** Applies `f` to every table, running all but the first on the shared threads */
+  private def concurrently(tables: Seq[TruthTable])(f: TruthTable => TruthTable): Seq[TruthTable] =
+    if (tables.size < 2) {
+      tables.map(f)
+    } else {
+      val rest = tables.tail.map(table => executor.submit(new Callable[TruthTable] { def call() = f(table) }))
+      try {
+        f(tables.head) +: rest.map { result =>
+          try result.get()
+          catch { case e: ExecutionException => throw e.getCause() }
+        }
+      } finally {
+        rest.foreach(_.cancel(true))
+      }
+    }
+
+  /** Identifies the espresso executable in PATH by its location and contents, so that cached outputs of other
+    * espresso builds are not used
+    */
+  private lazy val espressoIdentity: String =
+    sys.env
+      .getOrElse("PATH", "")
+      .split(File.pathSeparator)
+      .map(new File(_, "espresso"))
+      .find(_.canExecute())
+      .map { executable =>
+        executable.getAbsolutePath() + "\n" + digest(Files.readAllBytes(executable.toPath()))
+      }
+      .getOrElse("")
+
+  private def digest(bytes: Array[Byte]): String =
+    MessageDigest.getInstance("SHA-256").digest(bytes).map("%02x".format(_)).mkString
+
+  private def espresso(table: TruthTable, cacheDirectory: Option[File]): TruthTable = {
     def writeTable(table: TruthTable): String = {
       def invert(string: String) = string
         .replace('0', 't')
@@ -77,16 +147,44 @@ object EspressoMinimizer extends Minimizer with LazyLogging {
     logger.trace(s"""espresso input table:
                     |$input
                     |""".stripMargin)
-    val output =
+    def run(): String =
       try {
         os.proc("espresso").call(stdin = input).out.chunks.mkString
       } catch {
         case e: java.io.IOException if e.getMessage.contains("error=2, No such file or directory") =>
           throw EspressoNotFoundException
       }
+    val output = cacheDirectory match {
+      case None            => run()
+      case Some(directory) => cached(directory, input)(run())
+    }
     logger.trace(s"""espresso output table:
                     |$output
                     |""".stripMargin)
     TruthTable.fromEspressoOutput(readTable(output), table.default)
   }
+
+  /** Returns the output of espresso for `input`, either from the cache in `directory` or by calling `run`. Entries are
+    * keyed by the input and the espresso executable, and are written to a temporary file which is atomically moved
+    * into place, so a partially written entry is never read.
+    */
+  private def cached(directory: File, input: String)(run: => String): String = {
+    val key = digest((espressoIdentity + "\n" + input).getBytes(StandardCharsets.UTF_8))
+    val entry = new File(directory, key)
+    if (entry.isFile()) {
+      logger.trace(s"espresso output table restored from $entry")
+      new String(Files.readAllBytes(entry.toPath()), StandardCharsets.UTF_8)
+    } else {
+      val output = run
+      directory.mkdirs()
+      val staging = Files.createTempFile(directory.toPath(), s"$key.staging-", "")
+      try {
+        Files.write(staging, output.getBytes(StandardCharsets.UTF_8))
+        Files.move(staging, entry.toPath(), StandardCopyOption.ATOMIC_MOVE, StandardCopyOption.REPLACE_EXISTING)
+      } finally {
+        Files.deleteIfExists(staging)
+      }
+      output
+    }
+  }
 }
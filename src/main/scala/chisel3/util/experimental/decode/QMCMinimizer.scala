@@ -15,8 +15,8 @@ import scala.language.implicitConversions
   * which means, for large-scale [[TruthTable]] minimization task, it will be really slow,
   * and might run out of memory of JVM stack.
   *
-  * In this situation, users should consider switch to [[EspressoMinimizer]],
-  * which uses heuristic algorithm providing a sub-optimized result.
+  * In this situation, users should consider switch to [[BitParallelQMCMinimizer]], which gives the same result much
+  * faster, or to [[EspressoMinimizer]], which uses heuristic algorithm providing a sub-optimized result.
   */
 object QMCMinimizer extends Minimizer {
   private implicit def toImplicant(x: BitPat): Implicant = new Implicant(x)
@@ -13,7 +13,8 @@ object decoder extends LazyLogging {
 
   /** Use a specific [[Minimizer]] to generated decoded signals.
     *
-    * @param minimizer  specific [[Minimizer]], can be [[QMCMinimizer]] or [[EspressoMinimizer]].
+    * @param minimizer  specific [[Minimizer]], can be [[QMCMinimizer]], [[BitParallelQMCMinimizer]] or
+    *                   [[EspressoMinimizer]].
     * @param input      input signal that contains decode table input
     * @param truthTable [[TruthTable]] to decode user input.
     * @return decode table output.
@@ -49,16 +50,16 @@ object decoder extends LazyLogging {
     */
   def espresso(input: UInt, truthTable: TruthTable): UInt = apply(EspressoMinimizer, input, truthTable)
 
-  /** Use [[QMCMinimizer]] to generated decoded signals.
+  /** Use [[BitParallelQMCMinimizer]], which gives the same result as [[QMCMinimizer]], to generated decoded signals.
     *
     * @param input      input signal that contains decode table input
     * @param truthTable [[TruthTable]] to decode user input.
     * @return decode table output.
     */
-  def qmc(input: UInt, truthTable: TruthTable): UInt = apply(QMCMinimizer, input, truthTable)
+  def qmc(input: UInt, truthTable: TruthTable): UInt = apply(BitParallelQMCMinimizer, input, truthTable)
 
   /** try to use [[EspressoMinimizer]] to decode `input` by `truthTable`
-    * if `espresso` not exist in your PATH environment it will fall back to [[QMCMinimizer]], and print a warning.
+    * if `espresso` not exist in your PATH environment it will fall back to QMC (see [[qmc]]), and print a warning.
     *
     * @param input      input signal that contains decode table input
     * @param truthTable [[TruthTable]] to decode user input.
@@ -123,3 +123,24 @@ private[circt] case object SplitVerilog extends NoTargetAnnotation with CIRCTOpt
   )
 
 }
+
+/** Annotation that enables caching of firtool's outputs in a directory, which may be shared by concurrent processes.
+  * firtool is not run if its input FIRRTL (including annotations), its command line options and its version are
+  * identical to a previous run; instead, the files it wrote and its output are restored from the cache.
+  *
+  * @note The contents of files included via `--include-dir` are not part of the cache key.
+  */
+case class FirtoolCache(directory: String) extends NoTargetAnnotation with CIRCTOption
+
+object FirtoolCache extends HasShellOptions {
+
+  override def options = Seq(
+    new ShellOption[String](
+      longOption = "firtool-cache",
+      toAnnotationSeq = a => Seq(FirtoolCache(a)),
+      helpText = "A directory in which to cache the outputs of firtool",
+      helpValueName = Some("<directory>")
+    )
+  )
+
+}
@@ -10,20 +10,24 @@ import java.io.File
   * @param outputFile the name of the file where the result will be written, if not split
   * @param preserveAggregate causes CIRCT to not lower aggregate FIRRTL IR types
   * @param target the specific IR or language target that CIRCT should compile to
+  * @param firtoolCache a directory in which to cache the outputs of firtool, keyed by its inputs
   */
 class CIRCTOptions private[stage] (
   val outputFile:        Option[File] = None,
   val preserveAggregate: Option[PreserveAggregate.Type] = None,
   val target:            Option[CIRCTTarget.Type] = None,
   val firtoolOptions:    Seq[String] = Seq.empty,
-  val splitVerilog:      Boolean = false) {
+  val splitVerilog:      Boolean = false,
+  val firtoolCache:      Option[File] = None) {
 
   private[stage] def copy(
     outputFile:        Option[File] = outputFile,
     preserveAggregate: Option[PreserveAggregate.Type] = preserveAggregate,
     target:            Option[CIRCTTarget.Type] = target,
     firtoolOptions:    Seq[String] = firtoolOptions,
-    splitVerilog:      Boolean = splitVerilog
-  ): CIRCTOptions = new CIRCTOptions(outputFile, preserveAggregate, target, firtoolOptions, splitVerilog)
+    splitVerilog:      Boolean = splitVerilog,
+    firtoolCache:      Option[File] = firtoolCache
+  ): CIRCTOptions =
+    new CIRCTOptions(outputFile, preserveAggregate, target, firtoolOptions, splitVerilog, firtoolCache)
 
 }
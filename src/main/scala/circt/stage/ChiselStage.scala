@@ -4,9 +4,12 @@ package circt.stage
 
 import chisel3.RawModule
 import chisel3.stage.{
+  BinaryPrintfAnnotation,
   ChiselCircuitAnnotation,
   ChiselGeneratorAnnotation,
   CircuitSerializationAnnotation,
+  DefinitionThreadsAnnotation,
+  ElaborationProfileAnnotation,
   PrintFullStackTraceAnnotation,
   SourceRootAnnotation,
   ThrowOnFirstErrorAnnotation,
@@ -37,7 +40,11 @@ trait CLI { this: BareShell =>
     ThrowOnFirstErrorAnnotation,
     WarningsAsErrorsAnnotation,
     SourceRootAnnotation,
-    SplitVerilog
+    DefinitionThreadsAnnotation,
+    ElaborationProfileAnnotation,
+    BinaryPrintfAnnotation,
+    SplitVerilog,
+    FirtoolCache
   ).foreach(_.addOptions(parser))
 }
 
@@ -136,7 +143,8 @@ object ChiselStage {
     phase
       .transform(annos)
       .collectFirst {
-        case FirrtlCircuitAnnotation(a) => a
+        // Modules are converted lazily during compilation; materialize them, since callers may traverse them repeatedly
+        case FirrtlCircuitAnnotation(a) => a.copy(modules = a.modules.toList)
       }
       .get
   }
@@ -2,7 +2,7 @@
 
 package circt
 
-import circt.stage.{CIRCTOption, CIRCTTargetAnnotation, PreserveAggregate}
+import circt.stage.{CIRCTOption, CIRCTTargetAnnotation, FirtoolCache, PreserveAggregate}
 
 import firrtl.AnnotationSeq
 import firrtl.options.OptionsView
@@ -26,6 +26,7 @@ package object stage {
             case PreserveAggregate(a)     => acc.copy(preserveAggregate = Some(a))
             case FirtoolOption(a)         => acc.copy(firtoolOptions = acc.firtoolOptions :+ a)
             case SplitVerilog             => acc.copy(splitVerilog = true)
+            case FirtoolCache(a)          => acc.copy(firtoolCache = Some(new File(a)))
             case _                        => acc
           }
         }
@@ -6,16 +6,16 @@ import _root_.logger.LogLevel
 import chisel3.BuildInfo.{firtoolVersion, version => chiselVersion}
 import chisel3.InternalErrorException
 import chisel3.experimental.hierarchy.core.ImportDefinitionAnnotation
-import chisel3.stage.{ChiselCircuitAnnotation, DesignAnnotation, SourceRootAnnotation}
+import chisel3.stage.{ChiselCircuitAnnotation, CircuitSerializationAnnotation, DesignAnnotation, SourceRootAnnotation}
 import circt.stage.{CIRCTOptions, CIRCTTarget, EmittedMLIR, PreserveAggregate}
 import firrtl.annotations.JsonProtocol
-import firrtl.ir.CircuitWithAnnos
 import firrtl.options.Viewer.view
 import firrtl.options.{CustomFileEmission, Dependency, OptionsException, Phase, StageOptions, Unserializable}
 import firrtl.stage.FirrtlOptions
 import firrtl.{AnnotationSeq, EmittedVerilogCircuit, EmittedVerilogCircuitAnnotation}
 
 import java.io.File
+import scala.collection.JavaConverters._
 import scala.collection.mutable
 import scala.util.control.NoStackTrace
 
@@ -175,9 +175,11 @@ class CIRCT extends Phase {
       case a => Some(a)
     }
 
-    val input: String = firrtlOptions.firrtlCircuit match {
+    /* The input is serialized as it is piped to firtool, so that modules which are converted lazily (see
+     * [[chisel3.stage.phases.Convert]]) are never all held in memory at once. */
+    val input: Iterable[String] = firrtlOptions.firrtlCircuit match {
       case None          => throw new OptionsException("No input file specified!")
-      case Some(circuit) => CircuitWithAnnos(circuit = circuit, annotations = filteredAnnotations).serialize
+      case Some(circuit) => CircuitSerializationAnnotation.emitLazily(circuit, filteredAnnotations)
     }
 
     val chiselAnnotationFilename: Option[String] =
@@ -187,7 +189,7 @@ class CIRCT extends Phase {
 
     val binary = "firtool"
 
-    val cmd =
+    def command(outputDirectory: String): Seq[String] =
       Seq(binary, "-format=fir", "-warn-on-unprocessed-annotations", "-dedup") ++
         Seq("-output-annotation-file", circtAnnotationFilename) ++
         circtOptions.firtoolOptions ++
@@ -205,9 +207,9 @@ class CIRCT extends Phase {
         ((circtOptions.target, split) match {
           case (Some(CIRCTTarget.FIRRTL), false)        => Seq("-ir-fir")
           case (Some(CIRCTTarget.HW), false)            => Seq("-ir-hw")
-          case (Some(CIRCTTarget.Verilog), true)        => Seq("--split-verilog", s"-o=${stageOptions.targetDir}")
+          case (Some(CIRCTTarget.Verilog), true)        => Seq("--split-verilog", s"-o=$outputDirectory")
           case (Some(CIRCTTarget.Verilog), false)       => None
-          case (Some(CIRCTTarget.SystemVerilog), true)  => Seq("--split-verilog", s"-o=${stageOptions.targetDir}")
+          case (Some(CIRCTTarget.SystemVerilog), true)  => Seq("--split-verilog", s"-o=$outputDirectory")
           case (Some(CIRCTTarget.SystemVerilog), false) => None
           case (None, _) =>
             throw new Exception(
@@ -222,26 +224,37 @@ class CIRCT extends Phase {
               s"Invalid combination of circtOptions.target ${circtOptions.target} and split ${split}"
             )
         })
+    val cmd = command(stageOptions.targetDir)
+
+    def runFirtool(cmd: Seq[String]): String = {
+      val stdoutStream, stderrStream = new java.io.ByteArrayOutputStream
+      val stdoutWriter = new java.io.PrintWriter(stdoutStream)
+      val stderrWriter = new java.io.PrintWriter(stderrStream)
+      val exitValue =
+        try {
+          (cmd #< new java.io.SequenceInputStream(
+            input.iterator.map(chunk => new java.io.ByteArrayInputStream(chunk.getBytes)).asJavaEnumeration
+          ))
+            .!(ProcessLogger(stdoutWriter.println, stderrWriter.println))
+        } catch {
+          case a: java.lang.RuntimeException if a.getMessage().startsWith("No exit code") =>
+            throw new Exceptions.FirtoolNotFound(binary)
+        }
+      stdoutWriter.close()
+      stderrWriter.close()
+      val result = stdoutStream.toString
+      val errors = stderrStream.toString
+      if (exitValue != 0)
+        throw new Exceptions.FirtoolNonZeroExitCode(binary, exitValue, result, errors)
+      result
+    }
 
     logger.info(s"""Running CIRCT: '${cmd.mkString(" ")} < $$input'""")
-    val stdoutStream, stderrStream = new java.io.ByteArrayOutputStream
-    val stdoutWriter = new java.io.PrintWriter(stdoutStream)
-    val stderrWriter = new java.io.PrintWriter(stderrStream)
-    val exitValue =
-      try {
-        (cmd #< new java.io.ByteArrayInputStream(input.getBytes))
-          .!(ProcessLogger(stdoutWriter.println, stderrWriter.println))
-      } catch {
-        case a: java.lang.RuntimeException if a.getMessage().startsWith("No exit code") =>
-          throw new Exceptions.FirtoolNotFound(binary)
-      }
-    stdoutWriter.close()
-    stderrWriter.close()
-    val result = stdoutStream.toString
+    val result = circtOptions.firtoolCache match {
+      case None            => runFirtool(cmd)
+      case Some(directory) => FirtoolOutputCache(directory, command, input, stageOptions.targetDir)(runFirtool)
+    }
     logger.info(result)
-    val errors = stderrStream.toString
-    if (exitValue != 0)
-      throw new Exceptions.FirtoolNonZeroExitCode(binary, exitValue, result, errors)
     val finalAnnotations = if (split) {
       logger.info(result)
       val file = new File(stageOptions.getBuildFileName(circtAnnotationFilename, Some(".anno.json")))
@@ -278,3 +291,14 @@ class CIRCT extends Phase {
   }
 
 }
+
+object CIRCT {
+
+  /** The version reported by the `firtool` which [[CIRCT]] runs, which may differ from the version Chisel was published
+    * against. This is part of the key of every cache of firtool's outputs.
+    */
+  lazy val installedFirtoolVersion: String = {
+    import scala.sys.process._
+    scala.util.Try(Seq("firtool", "--version").!!).getOrElse("<unknown>")
+  }
+}
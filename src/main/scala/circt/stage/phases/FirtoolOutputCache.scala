@@ -0,0 +1,105 @@
+// SPDX-License-Identifier: Apache-2.0
+
+package circt.stage.phases
+
+import java.io.File
+import java.nio.charset.StandardCharsets
+import java.nio.file.{Files, Path, StandardCopyOption}
+import java.security.MessageDigest
+
+/** A content-addressed cache of the outputs of firtool, used by [[CIRCT]] when a [[circt.stage.FirtoolCache]] is
+  * specified.
+  *
+  * Entries are keyed by the firtool version, the command line and the input FIRRTL. Each entry holds firtool's standard
+  * output and every file it wrote to its output directory. On a miss, firtool is run with a fresh output directory so
+  * that exactly the files it writes are captured. Paths to the output directory which firtool embeds in its outputs
+  * (for instance, in `filelist.f`) are replaced with a placeholder in the cache, so entries can be restored into any
+  * target directory. Entries are staged in a temporary directory which is atomically moved into place, so they may be
+  * shared by concurrent processes.
+  */
+private[phases] object FirtoolOutputCache {
+
+  private val outputDirectoryPlaceholder = "${FIRTOOL_OUTPUT_DIRECTORY}"
+  private val stdoutFileName = "stdout"
+  private val outputDirectoryName = "output"
+
+  /** Returns firtool's standard output, either restored from the cache or by calling `run`.
+    *
+    * @param command the firtool command line, given the directory firtool should write files to
+    * @param input the input FIRRTL, which is traversed once to compute the key and again if firtool is run
+    * @param run runs firtool with the given command line, returning its standard output
+    */
+  def apply(
+    cacheDirectory:  File,
+    command:         String => Seq[String],
+    input:           Iterable[String],
+    targetDirectory: String
+  )(run:             Seq[String] => String
+  ): String = {
+    val key = {
+      val digest = MessageDigest.getInstance("SHA-256")
+      (Seq(CIRCT.installedFirtoolVersion) ++ command(outputDirectoryPlaceholder)).foreach { component =>
+        digest.update(component.getBytes(StandardCharsets.UTF_8))
+        digest.update(0.toByte)
+      }
+      input.foreach(chunk => digest.update(chunk.getBytes(StandardCharsets.UTF_8)))
+      digest.digest().map("%02x".format(_)).mkString
+    }
+    val entry = new File(cacheDirectory, key)
+
+    if (!entry.isDirectory()) {
+      cacheDirectory.mkdirs()
+      val staging = Files.createTempDirectory(cacheDirectory.toPath(), s"$key.staging-").toFile()
+      try {
+        val outputDirectory = new File(staging, outputDirectoryName)
+        outputDirectory.mkdir()
+        val stdout = run(command(outputDirectory.getAbsolutePath()))
+        // Standard output is stored beside the output directory, so it can never collide with a file firtool wrote
+        val stdoutFile = new File(staging, stdoutFileName).toPath()
+        write(stdoutFile, stdout.replace(outputDirectory.getAbsolutePath(), outputDirectoryPlaceholder))
+        files(outputDirectory).foreach { file =>
+          write(file, read(file).replace(outputDirectory.getAbsolutePath(), outputDirectoryPlaceholder))
+        }
+        try {
+          Files.move(staging.toPath(), entry.toPath(), StandardCopyOption.ATOMIC_MOVE)
+        } catch {
+          // Another process stored the same entry first
+          case _: java.nio.file.FileAlreadyExistsException | _: java.nio.file.DirectoryNotEmptyException =>
+        }
+      } finally {
+        if (staging.exists()) {
+          paths(staging).sortBy(-_.getNameCount()).foreach(Files.delete)
+        }
+      }
+    }
+
+    restore(new File(entry, outputDirectoryName), new File(targetDirectory))
+    read(new File(entry, stdoutFileName).toPath()).replace(outputDirectoryPlaceholder, targetDirectory)
+  }
+
+  private def restore(outputDirectory: File, targetDirectory: File): Unit = {
+    files(outputDirectory).foreach { file =>
+      val destination = targetDirectory.toPath().resolve(outputDirectory.toPath().relativize(file))
+      Files.createDirectories(destination.getParent())
+      write(destination, read(file).replace(outputDirectoryPlaceholder, targetDirectory.toString()))
+    }
+  }
+
+  /** `directory` and everything in it, recursively. */
+  private def paths(directory: File): Seq[Path] = {
+    val stream = Files.walk(directory.toPath())
+    try {
+      stream.toArray.toSeq.map(_.asInstanceOf[Path])
+    } finally {
+      stream.close()
+    }
+  }
+
+  /** All regular files in `directory`, recursively. */
+  private def files(directory: File): Seq[Path] = paths(directory).filter(Files.isRegularFile(_))
+
+  private def read(path: Path): String = new String(Files.readAllBytes(path), StandardCharsets.UTF_8)
+
+  private def write(path: Path, contents: String): Unit =
+    Files.write(path, contents.getBytes(StandardCharsets.UTF_8))
+}
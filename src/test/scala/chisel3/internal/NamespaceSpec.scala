@@ -78,4 +78,54 @@ class NamespaceSpec extends AnyFlatSpec {
     name("x") should be("x_2")
     name("x_0") should be("x_0_1")
   }
+
+  they should "support names ending in the separator" in {
+    val namespace = Namespace.empty
+    val name = namespace.name(_, false)
+    name("x") should be("x")
+    name("x_") should be("x_")
+    name("x_") should be("x__1")
+    name("x") should be("x_1")
+  }
+
+  they should "support indices too large to be numbers" in {
+    val namespace = Namespace.empty
+    val name = namespace.name(_, false)
+    name("x") should be("x")
+    name("x") should be("x_1")
+    name("x_99999999999999999999") should be("x_99999999999999999999")
+    name("x_99999999999999999999") should be("x_99999999999999999999_1")
+    name("x") should be("x_2")
+  }
+
+  they should "support names whose hash codes collide" in {
+    val namespace = Namespace.empty
+    val name = namespace.name(_, false)
+    "Aa".hashCode should be("BB".hashCode)
+    name("Aa") should be("Aa")
+    name("BB") should be("BB")
+    name("Aa") should be("Aa_1")
+    name("BB") should be("BB_1")
+    name("BB_1") should be("BB_1_1")
+    name("Aa_2") should be("Aa_2")
+    name("Aa") should be("Aa_3")
+    name("BB") should be("BB_2")
+  }
+
+  they should "keep every name and index as they grow" in {
+    val namespace = Namespace.empty
+    val name = namespace.name(_, false)
+    val n = 10000
+    (0 until n).foreach { i => name(s"n$i") should be(s"n$i") }
+    (0 until n).foreach { i => name(s"n$i") should be(s"n${i}_1") }
+    (0 until n).foreach { i => namespace.contains(s"n${i}_1") should be(true) }
+    namespace.contains(s"n$n") should be(false)
+    name(s"n${n}") should be(s"n${n}")
+
+    info("copies keep every name and index")
+    val copy = Namespace.empty
+    copy.name("n0") should be("n0")
+    namespace.copyTo(copy)
+    (0 until n).foreach { i => copy.name(s"n$i") should be(s"n${i}_2") }
+  }
 }
@@ -0,0 +1,125 @@
+// SPDX-License-Identifier: Apache-2.0
+
+package chisel3.internal.firrtl
+
+import chisel3._
+import chisel3.experimental.{DoubleParam, IntParam, StringParam}
+import chisel3.stage.{ChiselCircuitAnnotation, ChiselGeneratorAnnotation}
+import chisel3.util.Decoupled
+import firrtl.{ir => fir}
+import org.scalatest.flatspec.AnyFlatSpec
+import org.scalatest.matchers.should.Matchers
+
+object SerializerSpec {
+
+  class Child extends Module {
+    val in = IO(Input(SInt(8.W)))
+    val out = IO(Output(SInt(8.W)))
+    out := RegNext(in, -3.S)
+  }
+
+  class Constant
+      extends BlackBox(Map("VALUE" -> IntParam(4), "NAME" -> StringParam("constant"), "REAL" -> DoubleParam(0.5))) {
+    val io = IO(new Bundle { val out = Output(UInt(8.W)) })
+  }
+
+  class Empty extends RawModule {
+    val in = IO(Input(Bool()))
+  }
+
+  class Everything extends Module {
+    val io = IO(new Bundle {
+      val a = Input(UInt(8.W))
+      val b = Input(Vec(4, UInt(8.W)))
+      val sel = Input(UInt(2.W))
+      val flipped = Flipped(Decoupled(UInt(4.W)))
+      val out = Output(UInt(8.W))
+      val signed = Output(SInt(8.W))
+    })
+    io.flipped.ready := DontCare
+    io.out := io.b(io.sel) + io.a(3, 0) + 0x1f.U
+    io.signed := -1.S
+
+    val child = Module(new Child)
+    child.in := io.a.asSInt
+    val constant = Module(new Constant)
+
+    val wire = Wire(Vec(2, new Bundle { val x = UInt(3.W); val y = Bool() }))
+    wire := DontCare
+    val reg = Reg(UInt(8.W))
+    val regInit = RegInit(0.U(8.W))
+
+    when(io.a === 0.U) {
+      reg := io.a
+    }.elsewhen(io.a === 1.U) {
+      when(io.sel(0)) {
+        regInit := Mux(io.sel(1), io.a, constant.io.out)
+      }
+    }.otherwise {
+      // An empty scope
+    }
+    when(io.a > 2.U) {}.otherwise {
+      reg := reg << 1
+    }
+
+    val mem = Mem(16, UInt(8.W))
+    val syncMem = SyncReadMem(16, UInt(8.W))
+    when(io.flipped.valid) {
+      mem.write(io.sel, io.a)
+      syncMem.write(io.sel, mem.read(io.sel))
+    }
+    val read = syncMem.read(io.sel)
+    printf(cf"read=$read%x child=${child.out}\n")
+    assert(read =/= 3.U, "read %d", read)
+    when(reset.asBool) {
+      stop()
+    }
+
+    // A `when` at the end of a module
+    when(io.sel === 3.U) {
+      io.out := regInit ^ reg
+    }
+  }
+
+  class Top extends Module {
+    val out = IO(Output(UInt(8.W)))
+    val everything = Module(new Everything)
+    everything.io <> DontCare
+    out := everything.io.out
+    val empty = Module(new Empty)
+    empty.in := true.B
+  }
+}
+
+class SerializerSpec extends AnyFlatSpec with Matchers {
+  import SerializerSpec._
+
+  private def elaborate(gen: => RawModule): Circuit =
+    ChiselGeneratorAnnotation(() => gen).elaborate.collectFirst { case ChiselCircuitAnnotation(circuit) => circuit }.get
+
+  behavior.of("Serializer")
+
+  it should "serialize modules exactly as converting them to FIRRTL IR and serializing that would" in {
+    val circuit = elaborate(new Top)
+    circuit.components.size should be(5)
+    circuit.components.foreach { component =>
+      Serializer.lazily(component).mkString should be(fir.Serializer.lazily(Converter.convert(component), 1).mkString)
+    }
+  }
+
+  it should "serialize lazily converted circuits exactly as firrtl.ir.Serializer would" in {
+    val circuit = elaborate(new Top)
+    val annotations = circuit.firrtlAnnotations.toSeq
+    val expected = fir.Serializer.lazily(fir.CircuitWithAnnos(Converter.convert(circuit), annotations)).mkString
+    Serializer.lazily(Converter.convertLazily(circuit), annotations).mkString should be(expected)
+    info("circuits which were not lazily converted are serialized by firrtl.ir.Serializer")
+    Serializer.lazily(Converter.convert(circuit), annotations).mkString should be(expected)
+  }
+
+  "Lazily converted modules" should "be converted once and match eagerly converted modules" in {
+    val circuit = elaborate(new Top)
+    val modules = Converter.convertLazily(circuit).modules
+    modules should be(Converter.convert(circuit).modules)
+    modules.zip(modules.iterator.toSeq).foreach { case (a, b) => a should be theSameInstanceAs b }
+  }
+}
@@ -0,0 +1,116 @@
+// SPDX-License-Identifier: Apache-2.0
+
+package chiselTests
+
+import chisel3._
+import chisel3.experimental.hierarchy.Definition
+import chisel3.simulator.BinaryPrintfDecoder
+import circt.stage.ChiselStage
+import org.scalatest.flatspec.AnyFlatSpec
+import org.scalatest.matchers.should.Matchers
+
+import java.io.{ByteArrayInputStream, File, StringWriter}
+import java.nio.{ByteBuffer, ByteOrder}
+
+class BinaryPrintfSpec extends AnyFlatSpec with Matchers {
+
+  class Printer extends Module {
+    val a = IO(Input(UInt(8.W)))
+    val b = IO(Input(SInt(40.W)))
+    when(a === 1.U) {
+      printf(cf"a = $a%x, b = $b, ${Name(a)}: 100%%\n")
+    }
+    printf("no arguments\n")
+  }
+
+  /** The records of printfs, each an id and its words */
+  private def recordBytes(records: (Int, Seq[Int])*): Array[Byte] = {
+    val words = records.flatMap { case (id, words) => Seq(id, words.size) ++ words }
+    val buffer = ByteBuffer.allocate(words.size * 4).order(ByteOrder.LITTLE_ENDIAN)
+    words.foreach(buffer.putInt)
+    buffer.array
+  }
+
+  private def records(records: (Int, Seq[Int])*): ByteArrayInputStream =
+    new ByteArrayInputStream(recordBytes(records: _*))
+
+  class Printers extends Module {
+    // These collide with each other, so all but the first are elaborated again when built concurrently
+    val printers = Definition.concurrently(Seq.fill(3)(() => new Printer))
+  }
+
+  /** Elaborates a module, returning its CHIRRTL and the table of its printfs */
+  private def elaborateWithTable(gen: => RawModule, args: String*): (String, String) = {
+    val table = File.createTempFile("binary-printf", ".json")
+    try {
+      val chirrtl = ChiselStage.emitCHIRRTL(gen, Array("--binary-printf", table.toString) ++ args)
+      (chirrtl, new String(java.nio.file.Files.readAllBytes(table.toPath), "UTF-8"))
+    } finally {
+      table.delete()
+    }
+  }
+
+  private def elaborate(): (String, BinaryPrintfDecoder) = {
+    val (chirrtl, table) = elaborateWithTable(new Printer)
+    (chirrtl, BinaryPrintfDecoder.fromTable(table))
+  }
+
+  "Printfs" should "be lowered to binary printf channels" in {
+    val (chirrtl, _) = elaborate()
+    chirrtl should not include ("printf(")
+    chirrtl should include("defname = BinaryPrintf")
+    chirrtl should include("parameter WORDS = 3")
+    chirrtl should include("parameter WORDS = 0")
+  }
+
+  they should "be numbered in the order of their modules, whichever Definitions are elaborated concurrently" in {
+    val (serial, serialTable) = elaborateWithTable(new Printers)
+    val (concurrent, concurrentTable) = elaborateWithTable(new Printers, "--definition-threads", "4")
+    concurrent should be(serial)
+    concurrentTable should be(serialTable)
+    (0 until 6).foreach(id => serial should include(s"parameter ID = $id"))
+    serial should not include ("parameter ID = 6")
+    ujson.read(serialTable)("formats").arr should have size 6
+  }
+
+  they should "add the Verilog of the binary printf channels to the circuit once" in {
+    val (chirrtl, _) = elaborateWithTable(new Printers)
+    "BlackBoxInlineAnno".r.findAllMatchIn(chirrtl).size should be(1)
+  }
+
+  they should "be formatted from their records as they would be in simulation" in {
+    val (_, decoder) = elaborate()
+    val output = new StringWriter
+    // b is -2, as 40 bits
+    decoder.decode(records(0 -> Seq(0xab, 0xfffffffe, 0xff), 1 -> Seq.empty, 0 -> Seq(1, 3, 0)), output)
+    output.toString should be(
+      "a = ab, b = " + " " * 11 + "-2, a: 100%\n" +
+        "no arguments\n" +
+        "a = 01, b = " + " " * 12 + "3, a: 100%\n"
+    )
+  }
+
+  "BinaryPrintfDecoder" should "format arguments like Verilog" in {
+    def format(argument: BinaryPrintfDecoder.Argument, words: Int*): String = {
+      val output = new StringWriter
+      new BinaryPrintfDecoder(IndexedSeq(Seq(argument))).decode(records(0 -> words), output)
+      output.toString
+    }
+    format(BinaryPrintfDecoder.Argument('d', 8, false), 5) should be("  5")
+    format(BinaryPrintfDecoder.Argument('d', 8, true), 0xff) should be("  -1")
+    format(BinaryPrintfDecoder.Argument('x', 12, false), 0xa) should be("00a")
+    format(BinaryPrintfDecoder.Argument('b', 4, false), 5) should be("0101")
+    format(BinaryPrintfDecoder.Argument('c', 8, false), 'A'.toInt) should be("A")
+    format(BinaryPrintfDecoder.Argument('x', 64, false), 0x89abcdef, 0x01234567) should be("0123456789abcdef")
+  }
+
+  it should "reject records which do not match their format" in {
+    val decoder = new BinaryPrintfDecoder(IndexedSeq(Seq(BinaryPrintfDecoder.Argument('d', 8, false))))
+    an[IllegalArgumentException] should be thrownBy decoder.decode(records(1 -> Seq(0)), new StringWriter)
+    an[IllegalArgumentException] should be thrownBy decoder.decode(records(0 -> Seq(0, 0)), new StringWriter)
+    a[java.io.EOFException] should be thrownBy decoder.decode(
+      new ByteArrayInputStream(recordBytes(0 -> Seq(0)).dropRight(1)),
+      new StringWriter
+    )
+  }
+}
@@ -298,6 +298,40 @@ class VecSpec extends ChiselPropSpec with Utils {
     chirrtl should include("oneBitUnitRegVec[0] <= UInt<1>(\"h1\")")
   }
 
+  property("Vecs should only create the elements which are accessed") {
+    // Creating every element of these Vecs would take gigabytes of heap
+    val chirrtl = emitCHIRRTL(new Module {
+      val addr = IO(Input(UInt(24.W)))
+      val in = IO(Input(Vec(1 << 24, UInt(8.W))))
+      val out = IO(Output(UInt(8.W)))
+      val regs = Reg(Vec(1 << 24, new Bundle { val a = UInt(8.W); val b = UInt(8.W) }))
+      regs(3).a := in(5)
+      regs(addr).b := in(addr)
+      out := regs(addr).a + regs(3).b
+    })
+    chirrtl should include("input in : UInt<8>[16777216]")
+    chirrtl should include("reg regs : { a : UInt<8>, b : UInt<8>}[16777216], clock")
+    chirrtl should include("regs[3].a <= in[5]")
+    chirrtl should include("regs[addr].b <= in[addr]")
+  }
+
+  property("Vec elements first accessed from another module should belong to the Vec's module") {
+    class Child extends Module {
+      val io = IO(new Bundle { val vec = Output(Vec(8, new Bundle { val a = UInt(8.W); val b = UInt(8.W) })) })
+      io.vec(0).a := 1.U
+    }
+    var accessed: UInt = null
+    val chirrtl = emitCHIRRTL(new Module {
+      val out = IO(Output(UInt(8.W)))
+      val child = Module(new Child)
+      // Element 3 of the Vec, and its fields, are created here
+      accessed = child.io.vec(3).a
+      out := accessed
+    })
+    chirrtl should include("out <= child.io.vec[3].a")
+    accessed.parentModName should be("Child")
+  }
+
   property("A Vec with zero entries should compile and have zero width") {
 
     val chirrtl = emitCHIRRTL(new Module {
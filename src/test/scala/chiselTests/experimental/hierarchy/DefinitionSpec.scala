@@ -6,6 +6,7 @@ package experimental.hierarchy
 import chisel3._
 import chisel3.experimental.BaseModule
 import chisel3.experimental.hierarchy.{instantiable, public, Definition, Instance}
+import chisel3.stage.DefinitionThreadsAnnotation
 
 // TODO/Notes
 // - In backport, clock/reset are not automatically assigned. I think this is fixed in 3.5
@@ -596,4 +597,74 @@ class DefinitionSpec extends ChiselFunSpec with Utils {
       }
     }
   }
+  describe("(8): Definitions built concurrently") {
+    @instantiable
+    class Leaf(index: Int) extends Module {
+      override def desiredName = s"Leaf$index"
+      @public val in = IO(Input(UInt(8.W)))
+      @public val out = IO(Output(UInt(8.W)))
+      out := RegNext(in + index.U)
+    }
+    class Top extends Module {
+      val in = IO(Input(UInt(8.W)))
+      val out = IO(Output(UInt(8.W)))
+      val leaves = Definition.concurrently((0 until 8).map(index => () => new Leaf(index)))
+      // These collide with each other, and with modules of the same name built outside of them
+      val parameterized = Module(new AddOneParameterized(8))
+      val collisions = Definition.concurrently(Seq(4, 8, 8, 16).map(width => () => new AddOneParameterized(width)))
+      val nested = Definition.concurrently((4 until 7).map(width => () => new AddOneWithNested(width)))
+      out := leaves.foldLeft(in) {
+        case (prev, definition) =>
+          val leaf = Instance(definition)
+          leaf.in := prev
+          leaf.out
+      }
+      parameterized.in := in
+      collisions.foreach(definition => Instance(definition).in := in)
+      nested.foreach(definition => Instance(definition))
+    }
+    it("(8.a): should produce the same circuit as building each Definition in turn") {
+      val (serial, _) = getFirrtlAndAnnos(new Top)
+      val (concurrent, _) = getFirrtlAndAnnos(new Top, Seq(DefinitionThreadsAnnotation(4)))
+      concurrent.serialize should be(serial.serialize)
+      serial.serialize should include("module AddOneParameterized_4 :")
+    }
+    it("(8.b): should elaborate Definitions on other threads") {
+      val threads = java.util.concurrent.ConcurrentHashMap.newKeySet[Thread]()
+      class Top extends Module {
+        val leaves = Definition.concurrently((0 until 4).map { index =>
+          () => {
+            threads.add(Thread.currentThread())
+            new Leaf(index)
+          }
+        })
+      }
+      val (chirrtl, _) = getFirrtlAndAnnos(new Top, Seq(DefinitionThreadsAnnotation(2)))
+      (0 until 4).foreach { index => chirrtl.serialize should include(s"module Leaf$index :") }
+      threads should not contain (Thread.currentThread())
+    }
+    it("(8.c): should share one thread pool with nested Definitions, which are built serially") {
+      val threads = java.util.concurrent.ConcurrentHashMap.newKeySet[Thread]()
+      @instantiable
+      class Group(group: Int) extends Module {
+        override def desiredName = s"Group$group"
+        val leaves = Definition.concurrently((0 until 3).map { index =>
+          () => {
+            threads.add(Thread.currentThread())
+            new Leaf(group * 3 + index)
+          }
+        })
+        leaves.foreach(definition => Instance(definition))
+      }
+      class Top extends Module {
+        val groups = Definition.concurrently((0 until 4).map(group => () => new Group(group)))
+        groups.foreach(definition => Instance(definition))
+      }
+      val (serial, _) = getFirrtlAndAnnos(new Top)
+      threads.clear()
+      val (concurrent, _) = getFirrtlAndAnnos(new Top, Seq(DefinitionThreadsAnnotation(2)))
+      concurrent.serialize should be(serial.serialize)
+      threads.size should be <= 2
+    }
+  }
 }
@@ -5,6 +5,8 @@ package experimental.hierarchy
 
 import chisel3._
 import chisel3.util.Valid
+import chisel3.stage.{ChiselCircuitAnnotation, ChiselGeneratorAnnotation, CircuitSerializationAnnotation}
+import chisel3.stage.CircuitSerializationAnnotation.FirrtlFileFormat
 import chisel3.experimental.hierarchy._
 import circt.stage.ChiselStage.convert
 import chisel3.internal.instantiable
@@ -46,6 +48,19 @@ object InstantiateSpec {
     out := in + n.U
   }
 
+  object Counted {
+    var elaborations = 0
+  }
+  class Counted extends Module {
+    Counted.elaborations += 1
+    val in = IO(Input(UInt(8.W)))
+  }
+
+  class OneArgWrapper(n: Int) extends Module {
+    override def desiredName = s"OneArgWrapper$n"
+    val inst = Instantiate(new OneArg(3))
+  }
+
   @instantiable
   class ThreeArgs(n: Int, m: Int, o: String) extends Module {
     @public val in = IO(Input(UInt(8.W)))
@@ -328,6 +343,42 @@ class InstantiateSpec extends ChiselFunSpec with Utils {
       assert(modules2 == Seq("OneArg", "Top"))
     }
 
+    it("should be shared between elaborations given the same InstantiateCache") {
+      class MyTop(extra: Boolean) extends Top {
+        if (extra) {
+          // Takes the name the Definitions had in earlier elaborations
+          val counted = Module(new Module { override def desiredName = "Counted" })
+        }
+        val inst = Instantiate(new Counted)
+        val wrappers = Seq(1, 2).map(n => Instance(Definition(new OneArgWrapper(n))))
+      }
+      def emit(gen: => RawModule, cache: Option[InstantiateCache]): String = {
+        val annotations = (new circt.stage.ChiselStage).execute(
+          Array("--target", "chirrtl", "--target-dir", "test_run_dir/InstantiateSpec"),
+          Seq(ChiselGeneratorAnnotation(() => gen)) ++ cache.map(InstantiateCacheAnnotation(_))
+        )
+        annotations.collectFirst {
+          case ChiselCircuitAnnotation(circuit) =>
+            CircuitSerializationAnnotation(circuit, "", FirrtlFileFormat).emitLazily(Nil).mkString
+        }.get
+      }
+      val expected = emit(new MyTop(false), None)
+      Counted.elaborations = 0
+      val cache = new InstantiateCache
+      info("the first elaboration builds every Definition")
+      emit(new MyTop(false), Some(cache)) should be(expected)
+      Counted.elaborations should be(1)
+      info("later elaborations reuse them, producing exactly the same circuit")
+      emit(new MyTop(false), Some(cache)) should be(expected)
+      Counted.elaborations should be(1)
+      info("Definitions which would be given other names are elaborated again")
+      emit(new MyTop(true), Some(cache)) should be(emit(new MyTop(true), None))
+      Counted.elaborations should be(3)
+      info("elaborations without the cache do not use it")
+      emit(new MyTop(false), None) should be(expected)
+      Counted.elaborations should be(4)
+    }
+
     it("should properly handle case objects as parameters") {
       class MyTop extends Top {
         val inst0 = Instantiate(new ModuleParameterizedByProductTypes(FooEnum))
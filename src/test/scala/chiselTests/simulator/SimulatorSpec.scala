@@ -65,5 +65,32 @@ class SimulatorSpec extends AnyFunSpec with Matchers {
         .result
       assert(result === 12)
     }
+
+    it("reuses cached artifacts when simulating a SerializableModuleGenerator") {
+      import chisel3.experimental.SerializableModuleGenerator
+      import chiselTests.experimental.{GCDSerializableModule, GCDSerializableModuleParameter}
+      val cachePath = "test_run_dir/simulator/ArtifactCache/cache"
+      Runtime.getRuntime().exec(Array("rm", "-rf", cachePath)).waitFor()
+      val simulator = new VerilatorSimulator("test_run_dir/simulator/ArtifactCache/workspace") {
+        override val artifactCache = Some(ArtifactCache(cachePath))
+      }
+      val generator = SerializableModuleGenerator(classOf[GCDSerializableModule], GCDSerializableModuleParameter(32))
+      def simulate() = simulator.simulate(generator) { (_, gcd) =>
+        import PeekPokeAPI._
+        gcd.io.a.poke(24.U)
+        gcd.io.b.poke(36.U)
+        gcd.io.e.poke(1.B)
+        gcd.clock.step()
+        gcd.io.e.poke(0.B)
+        gcd.clock.step(20)
+        gcd.io.z.peek().litValue
+      }
+      val uncached = simulate()
+      val cached = simulate()
+      assert(uncached.result === 12)
+      assert(cached.result === 12)
+      uncached.phaseTimings.map(_.name) must not contain ("compilation/restore-from-cache")
+      cached.phaseTimings.map(_.name) must contain("compilation/restore-from-cache")
+    }
   }
 }
@@ -19,7 +19,8 @@ class ChiselOptionsViewSpec extends AnyFlatSpec with Matchers {
     val annotations = Seq(
       PrintFullStackTraceAnnotation,
       ChiselOutputFileAnnotation("foo"),
-      ChiselCircuitAnnotation(bar)
+      ChiselCircuitAnnotation(bar),
+      DefinitionThreadsAnnotation(4)
     )
     val out = view[ChiselOptions](annotations)
 
@@ -32,6 +33,9 @@ class ChiselOptionsViewSpec extends AnyFlatSpec with Matchers {
     info("chiselCircuit was set to circuit 'bar'")
     out.chiselCircuit should be(Some(bar))
 
+    info("definitionThreads was set to 4")
+    out.definitionThreads should be(4)
+
   }
 
 }
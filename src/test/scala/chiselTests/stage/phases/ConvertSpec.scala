@@ -50,4 +50,22 @@ class ConvertSpec extends AnyFlatSpec with Matchers {
 
   }
 
+  it should "convert modules lazily, once each" in new Fixture {
+    val annos: AnnotationSeq = Seq(ChiselGeneratorAnnotation(() => new ConvertSpecFoo))
+
+    val annosx = Seq(new Elaborate, phase)
+      .foldLeft(annos)((a, p) => p.transform(a))
+
+    val circuit = annosx.collectFirst { case a: FirrtlCircuitAnnotation => a.circuit }.get
+    val first = circuit.modules.toList
+    val second = circuit.modules.iterator.toList
+
+    info("each module is converted once, and every traversal returns the same converted module")
+    first.zip(second).foreach { case (a, b) => a should be theSameInstanceAs b }
+    circuit.modules.head should be theSameInstanceAs first.head
+
+    info("the lazily converted circuit serializes identically to a materialized one")
+    circuit.serialize should be(circuit.copy(modules = circuit.modules.toList).serialize)
+  }
+
 }
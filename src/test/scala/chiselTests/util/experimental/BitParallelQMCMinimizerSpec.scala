@@ -0,0 +1,51 @@
+// SPDX-License-Identifier: Apache-2.0
+
+package chiselTests.util.experimental
+
+import chisel3.util.BitPat
+import chisel3.util.experimental.decode.{BitParallelQMCMinimizer, QMCMinimizer, TruthTable}
+import org.scalatest.flatspec.AnyFlatSpec
+
+import scala.util.Random
+
+class BitParallelQMCMinimizerSpec extends AnyFlatSpec {
+  private def randomTable(random: Random, inputWidth: Int, outputWidth: Int, entries: Int): TruthTable = {
+    def bits(width: Int, chars: String) = Seq.fill(width)(chars(random.nextInt(chars.length))).mkString
+    // Inputs have distinct prefixes, and only have a don't care in their last bit, so that they never overlap
+    val prefixes = Seq.fill(entries)(bits(inputWidth - 1, "01")).distinct
+    TruthTable(
+      prefixes.map { prefix =>
+        BitPat(s"b$prefix${bits(1, "01?")}") -> BitPat(s"b${bits(outputWidth, "01?")}")
+      },
+      BitPat(s"b${bits(outputWidth, "01?")}")
+    )
+  }
+
+  "BitParallelQMCMinimizer" should "give the same result as QMCMinimizer" in {
+    val random = new Random(0)
+    for (_ <- 0 until 50) {
+      val table = randomTable(random, 6, 4, 1 + random.nextInt(12))
+      assert(BitParallelQMCMinimizer.minimize(table) == QMCMinimizer.minimize(table), s"for table:\n$table")
+    }
+  }
+
+  it should "give the same result as QMCMinimizer for inputs wider than 64 bits" in {
+    val random = new Random(1)
+    for (_ <- 0 until 5) {
+      val table = randomTable(random, 70, 3, 1 + random.nextInt(6))
+      assert(BitParallelQMCMinimizer.minimize(table) == QMCMinimizer.minimize(table), s"for table:\n$table")
+    }
+  }
+
+  it should "reject overlapping entries" in {
+    val table = TruthTable.fromString(
+      """0?->1
+        |01->0
+        |?
+        |""".stripMargin
+    )
+    intercept[IllegalArgumentException] {
+      BitParallelQMCMinimizer.minimize(table)
+    }
+  }
+}
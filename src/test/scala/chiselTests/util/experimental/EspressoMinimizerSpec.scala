@@ -0,0 +1,50 @@
+// SPDX-License-Identifier: Apache-2.0
+
+package chiselTests.util.experimental
+
+import chisel3.util.BitPat
+import chisel3.util.experimental.decode.{EspressoMinimizer, TruthTable}
+import org.scalatest.flatspec.AnyFlatSpec
+
+import java.nio.file.Files
+
+class EspressoMinimizerSpec extends AnyFlatSpec {
+  private def espressoAvailable =
+    sys.env.getOrElse("PATH", "").split(":").exists(new java.io.File(_, "espresso").canExecute)
+
+  val table = TruthTable.fromString(
+    """001->1
+      |010->1
+      |100->1
+      |101->1
+      |0""".stripMargin
+  )
+
+  "EspressoMinimizer" should "minimize the sub-tables of a table concurrently" in {
+    assume(espressoAvailable, "espresso is not in PATH")
+    val mixed = TruthTable.fromString(
+      """001->101
+        |010->1?0
+        |100->0?1
+        |01?""".stripMargin
+    )
+    val cacheDirectory = Files.createTempDirectory("espresso-cache").toFile
+    val minimized = EspressoMinimizer.cachedIn(cacheDirectory).minimize(mixed)
+    // espresso is run once for each kind of default bit
+    assert(cacheDirectory.listFiles.size == 3)
+    assert(EspressoMinimizer.cachedIn(cacheDirectory).minimize(mixed) == minimized)
+  }
+
+  it should "reuse cached results" in {
+    assume(espressoAvailable, "espresso is not in PATH")
+    val cacheDirectory = Files.createTempDirectory("espresso-cache").toFile
+    val minimized = EspressoMinimizer.cachedIn(cacheDirectory).minimize(table)
+    val entries = cacheDirectory.listFiles.toSeq
+    assert(entries.size == 1)
+    // An empty espresso output, so that a result from the cache can be told apart
+    Files.write(entries.head.toPath, ".i 3\n.o 1\n.e\n".getBytes)
+    val cached = EspressoMinimizer.cachedIn(cacheDirectory).minimize(table)
+    assert(cached != minimized)
+    assert(cached.table.map(_._1) == Seq(BitPat("b???")))
+  }
+}
@@ -65,6 +65,16 @@ object ChiselStageSpec {
     b := qux.b
   }
 
+  class Leaf(width: Int) extends RawModule {
+    override def desiredName = "Leaf"
+    val a = IO(Input(UInt(width.W)))
+  }
+
+  // The Leaves have the same desired name, so only the first of them is kept when they are built concurrently
+  class Leaves extends RawModule {
+    val leaves = experimental.hierarchy.Definition.concurrently((1 to 3).map(width => () => new Leaf(width)))
+  }
+
   import firrtl.annotations.NoTargetAnnotation
   import firrtl.options.Unserializable
   case object DummyAnnotation extends NoTargetAnnotation with Unserializable
@@ -156,6 +166,45 @@ class ChiselStageSpec extends AnyFunSpec with Matchers with chiselTests.Utils {
 
     }
 
+    it("should write an elaboration profile") {
+      val targetDir = baseDir / "elaboration-profile"
+      os.remove.all(targetDir)
+      os.makeDir.all(targetDir)
+
+      def profile(file: String, gen: => chisel3.RawModule = new ChiselStageSpec.Quz, args: Seq[String] = Nil) = {
+        val stageArgs =
+          Array("--target", "chirrtl", "--target-dir", targetDir.toString, "--elaboration-profile", file) ++ args
+        (new ChiselStage).execute(stageArgs, Seq(ChiselGeneratorAnnotation(() => gen)))
+        os.read(targetDir / os.RelPath(file))
+      }
+
+      info("a report is written for each module class and desired name, in the target directory")
+      val report = profile("profile.tsv").split("\n").map(_.split("\t").toSeq).toSeq
+      report.head should be(
+        Seq("class", "desired_name", "modules", "inclusive_ns", "exclusive_ns", "allocated_bytes", "commands", "ids")
+      )
+      report.tail.map(_.take(3)) should contain theSameElementsAs Seq(
+        Seq(classOf[ChiselStageSpec.Quz].getName, "Quz", "1"),
+        Seq(classOf[ChiselStageSpec.Qux].getName, "Qux", "1")
+      )
+
+      info("trace events are written for a .json file")
+      val events = ujson.read(profile("profile.json"))("traceEvents").arr
+      events.map(_("name").str) should be(Seq("Quz", "Qux"))
+      events.map(_("ph").str).distinct should be(Seq("X"))
+      events(1)("args")("commands").num should be > 0.0
+
+      info("Definitions built concurrently are recorded once, in their parents' contexts")
+      val concurrent = ujson.read(
+        profile("concurrent.json", new ChiselStageSpec.Leaves, Seq("--definition-threads", "2"))
+      )("traceEvents").arr
+      concurrent.map(_("name").str) should contain theSameElementsAs Seq("Leaves", "Leaf", "Leaf_1", "Leaf_2")
+      concurrent.foreach { event =>
+        event("args")("ids").num should be < 100.0
+        event("args")("exclusiveNanos").num should be >= 0.0
+      }
+    }
+
     it("should compile a Chisel module to FIRRTL dialect") {
 
       val targetDir = new File("test_run_dir/ChiselStageSpec")
@@ -246,6 +295,38 @@ class ChiselStageSpec extends AnyFunSpec with Matchers with chiselTests.Utils {
         .value should include("case")
     }
 
+    it("should restore split Verilog from a firtool cache") {
+      val cacheDir = new File("test_run_dir/ChiselStageSpec/firtool-cache")
+      val targetDir = new File("test_run_dir/ChiselStageSpec/firtool-cache-target")
+      val expectedOutput = new File(targetDir, "Foo.sv")
+      Seq(cacheDir, targetDir).foreach(dir => os.remove.all(os.Path(dir.getAbsoluteFile())))
+
+      val args: Array[String] = Array(
+        "--target",
+        "systemverilog",
+        "--split-verilog",
+        "--target-dir",
+        targetDir.toString,
+        "--firtool-cache",
+        cacheDir.toString
+      )
+
+      def run(): String = {
+        (new ChiselStage).execute(args, Seq(ChiselGeneratorAnnotation(() => new ChiselStageSpec.Foo)))
+        expectedOutput should (exist)
+        new String(java.nio.file.Files.readAllBytes(expectedOutput.toPath()))
+      }
+
+      info("the first run populates the cache")
+      val uncached = run()
+      cacheDir.listFiles().length should be(1)
+
+      info("the second run restores the same outputs from the cache")
+      os.remove.all(os.Path(targetDir.getAbsoluteFile()))
+      run() should be(uncached)
+      cacheDir.listFiles().length should be(1)
+    }
+
     it("should support aggregate preservation mode") {
       val targetDir = new File("test_run_dir/ChiselStageSpec")
 
@@ -0,0 +1,214 @@
+// SPDX-License-Identifier: Apache-2.0
+/**
+ * driver-benchmark.cpp
+ *
+ * Microbenchmarks for the primitives of `simulation-driver.cpp`, measured in
+ * isolation from any simulator. The driver is compiled into this executable
+ * with a fake backend whose ports are plain memory and whose `run_simulation`
+ * does nothing, so the results reflect only the cost of the driver itself.
+ *
+ * Build and run with:
+ *   c++ -O2 -I$(verilator --getenv VERILATOR_ROOT)/include/vltstd \
+ *     -I../../../../src/main/resources driver-benchmark.cpp -o driver-benchmark
+ *   ./driver-benchmark
+ *
+ * Results are written to `stdout` as tab-separated `<benchmark>\t<ops/sec>`
+ * lines, so they can be compared across commits.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "svdpi.h"
+
+// Declarations which a real backend provides via its generated DPI headers
+#define DPI_TASK_RETURN_TYPE int
+#define DPI_TASK_RETURN_VALUE 0
+extern "C" {
+void simulation_initializeTrace(const char *traceFilePath);
+void simulation_enableTrace();
+void simulation_disableTrace();
+}
+
+// Rename the driver's `main`, since this executable provides its own
+#define main simulation_driver_main
+#include "simulation-driver.cpp"
+#undef main
+
+// -- Fake Backend
+
+static const int portBitWidths[] = {1, 8, 64, 1024, 65536};
+static const int portCount = sizeof(portBitWidths) / sizeof(portBitWidths[0]);
+static uint8_t portStorage[portCount][65536 / 8];
+
+template <int id> static void getPort(uint8_t *value) {
+  memcpy(value, portStorage[id], (portBitWidths[id] + 7) / 8);
+}
+template <int id> static void setPort(const uint8_t *value) {
+  memcpy(portStorage[id], value, (portBitWidths[id] + 7) / 8);
+}
+static void (*const portGetters[])(uint8_t *) = {getPort<0>, getPort<1>,
+                                                  getPort<2>, getPort<3>,
+                                                  getPort<4>};
+static void (*const portSetters[])(const uint8_t *) = {
+    setPort<0>, setPort<1>, setPort<2>, setPort<3>, setPort<4>};
+
+extern "C" {
+
+int port_getter(int id, int *bitWidth, void (**getter)(uint8_t *)) {
+  if (id < 0 || id >= portCount)
+    return -1;
+  *bitWidth = portBitWidths[id];
+  *getter = portGetters[id];
+  return 0;
+}
+
+int port_setter(int id, int *bitWidth, void (**setter)(const uint8_t *)) {
+  if (id < 0 || id >= portCount)
+    return -1;
+  *bitWidth = portBitWidths[id];
+  *setter = portSetters[id];
+  return 0;
+}
+
+void run_simulation(int timesteps) {}
+void simulation_main(int argc, const char **argv) {}
+void simulation_initializeTrace(const char *traceFilePath) {}
+void simulation_enableTrace() {}
+void simulation_disableTrace() {}
+
+static svScope currentScope = NULL;
+svScope svGetScope() { return currentScope; }
+svScope svSetScope(const svScope scope) {
+  svScope previous = currentScope;
+  currentScope = scope;
+  return previous;
+}
+
+} // extern "C"
+
+// -- Harness
+
+static double now() {
+  struct timespec time;
+  clock_gettime(CLOCK_MONOTONIC, &time);
+  return time.tv_sec + time.tv_nsec * 1e-9;
+}
+
+static void report(const char *name, int bitWidth, long operations,
+                   double seconds) {
+  printf("%s/%d\t%.0f\n", name, bitWidth, operations / seconds);
+  fflush(stdout);
+}
+
+// Returns a hexadecimal value which is exactly `bitWidth` bits wide
+static char *fullWidthHexValue(int bitWidth) {
+  int digitCount = (bitWidth + 3) / 4;
+  char *value = (char *)malloc(digitCount + 1);
+  assert(value != NULL);
+  static const char highDigits[] = {'F', '1', '3', '7'};
+  value[0] = highDigits[bitWidth % 4];
+  memset(value + 1, 'A', digitCount - 1);
+  value[digitCount] = '\0';
+  return value;
+}
+
+// Feeds `commands` to `processCommand` `repetitions` times
+static double processCommands(const char *commands, long repetitions) {
+  size_t length = strlen(commands);
+  double elapsed = 0;
+  for (long repetition = 0; repetition < repetitions; repetition++) {
+    commandStream = fmemopen((void *)commands, length, "r");
+    assert(commandStream != NULL);
+    double start = now();
+    while (ftell(commandStream) < (long)length)
+      processCommand();
+    elapsed += now() - start;
+    fclose(commandStream);
+  }
+  return elapsed;
+}
+
+// Repeats `line` `count` times
+static char *repeatLine(const char *line, long count) {
+  size_t lineLength = strlen(line);
+  char *buffer = (char *)malloc(lineLength * count + 1);
+  assert(buffer != NULL);
+  for (long index = 0; index < count; index++)
+    memcpy(buffer + index * lineLength, line, lineLength);
+  buffer[lineLength * count] = '\0';
+  return buffer;
+}
+
+int main(int argc, const char **argv) {
+  // Messages are discarded, since we are measuring the driver, not the pipe
+  messageStream = fopen("/dev/null", "w");
+  assert(messageStream != NULL);
+  laneScopes = (svScope *)calloc(sizeof(svScope), laneCount);
+  assert(laneScopes != NULL);
+
+  for (int id = 0; id < portCount; id++) {
+    int bitWidth = portBitWidths[id];
+    long operations = bitWidth >= 4096 ? 2000 : 200000;
+    char *value = fullWidthHexValue(bitWidth);
+    size_t valueLength = strlen(value);
+
+    // Decoding a hexadecimal value
+    {
+      double start = now();
+      for (long operation = 0; operation < operations; operation++) {
+        const char *cursor = value;
+        free(scanHexBits(&cursor, value + valueLength, bitWidth,
+                         "benchmarking"));
+      }
+      report("scanHexBits", bitWidth, operations, now() - start);
+    }
+
+    // Encoding a hexadecimal value
+    if (bitWidth > 1) {
+      int byteCount = (bitWidth + 7) / 8;
+      uint8_t *bytes = (uint8_t *)malloc(byteCount);
+      assert(bytes != NULL);
+      double start = now();
+      for (long operation = 0; operation < operations; operation++) {
+        memset(bytes, 0xA5, byteCount);
+        sendBits(bytes, bitWidth, true);
+      }
+      report("sendBits", bitWidth, operations, now() - start);
+      free(bytes);
+    }
+
+    // Complete SET_BITS and GET_BITS commands, including parsing
+    {
+      char line[65536 / 4 + 32];
+      snprintf(line, sizeof(line), "S %X %s\n", id, value);
+      char *commands = repeatLine(line, operations / 10);
+      report("SET_BITS", bitWidth, operations,
+             processCommands(commands, 10));
+      free(commands);
+
+      snprintf(line, sizeof(line), "G u %X\n", id);
+      commands = repeatLine(line, operations / 10);
+      report("GET_BITS", bitWidth, operations,
+             processCommands(commands, 10));
+      free(commands);
+    }
+
+    free(value);
+  }
+
+  // The per-cycle overhead of TICK, with and without a sentinel port
+  {
+    long cycles = 10000000;
+    char command[64];
+    snprintf(command, sizeof(command), "T 0 0,1-1*%lX\n", cycles);
+    report("TICK", 1, cycles, processCommands(command, 1));
+    snprintf(command, sizeof(command), "T 0 0,1-1*%lX 2=1\n", cycles);
+    report("TICK_with_sentinel", 64, cycles, processCommands(command, 1));
+  }
+
+  return 0;
+}
@@ -0,0 +1,72 @@
+// SPDX-License-Identifier: Apache-2.0
+
+package svsimBenchmarks
+
+import svsim._
+
+/** Generated designs which scale in port count and port width, used to measure the overhead of svsim itself rather than of the design being simulated.
+  */
+object Designs {
+
+  /** A module with `portCount` registered pass-through ports of `bitWidth` bits each. When `verbose` is set, the module logs the value of its first output every cycle.
+    */
+  def elaboratePassthrough(workspace: Workspace, portCount: Int, bitWidth: Int): Unit = {
+    val moduleName = "Passthrough"
+    val writer = new java.io.PrintWriter(s"${workspace.primarySourcesPath}/$moduleName.sv")
+    try {
+      val ports = (0 until portCount).flatMap { index =>
+        Seq(
+          s"  input  [${bitWidth - 1}:0] in_$index",
+          s"  output reg [${bitWidth - 1}:0] out_$index"
+        )
+      }
+      writer.println(s"module $moduleName(")
+      writer.println((Seq("  input clock", "  input verbose") ++ ports).mkString(",\n"))
+      writer.println(");")
+      writer.println("  always @(posedge clock) begin")
+      (0 until portCount).foreach { index =>
+        writer.println(s"    out_$index <= in_$index;")
+      }
+      writer.println("    if (verbose) $display(\"out_0=%h\", out_0);")
+      writer.println("  end")
+      writer.println("endmodule")
+    } finally {
+      writer.close()
+    }
+    workspace.elaborate(
+      ModuleInfo(
+        name = moduleName,
+        ports = Seq(
+          ModuleInfo.Port("clock", isSettable = true),
+          ModuleInfo.Port("verbose", isSettable = true)
+        ) ++ (0 until portCount).flatMap { index =>
+          Seq(
+            ModuleInfo.Port(s"in_$index", isSettable = true, isGettable = true),
+            ModuleInfo.Port(s"out_$index", isGettable = true)
+          )
+        }
+      )
+    )
+  }
+
+  /** Creates a fresh workspace containing a `Passthrough` design and its generated harness.
+    */
+  def passthroughWorkspace(path: String, portCount: Int, bitWidth: Int): Workspace = {
+    val workspace = new Workspace(path = path)
+    workspace.reset()
+    elaboratePassthrough(workspace, portCount, bitWidth)
+    workspace.generateAdditionalSources()
+    workspace
+  }
+
+  def compile(workspace: Workspace): Simulation = {
+    val backend = verilator.Backend.initializeFromProcessEnvironment()
+    workspace.compile(backend)(
+      workingDirectoryTag = "verilator",
+      commonSettings = CommonCompilationSettings(),
+      backendSpecificSettings = verilator.Backend.CompilationSettings(),
+      customSimulationWorkingDirectory = None,
+      verbose = false
+    )
+  }
+}
@@ -0,0 +1,157 @@
+// SPDX-License-Identifier: Apache-2.0
+
+package svsimBenchmarks
+
+import java.util.concurrent.TimeUnit
+import org.openjdk.jmh.annotations._
+import svsim._
+
+object SimulationBenchmarks {
+
+  /** The number of protocol operations performed per benchmark invocation. Each invocation launches a simulation process, so this should be large enough to amortize process startup (which is measured separately by `ProcessStartupBenchmark`).
+    */
+  final val OperationCount = 100000
+}
+
+/** Measures the throughput of the command/message protocol between `Simulation.Controller` and `simulation-driver.cpp`.
+  */
+@State(Scope.Benchmark)
+@BenchmarkMode(Array(Mode.Throughput))
+@OutputTimeUnit(TimeUnit.SECONDS)
+@Warmup(iterations = 2)
+@Measurement(iterations = 5)
+@Fork(1)
+class ProtocolBenchmark {
+  import SimulationBenchmarks.OperationCount
+
+  @Param(Array("1", "64"))
+  var portCount: Int = _
+
+  @Param(Array("8", "64", "1024"))
+  var bitWidth: Int = _
+
+  var simulation: Simulation = _
+
+  // Setting the high bit makes every value full-width, which exercises the hexadecimal encoding and decoding on both sides of the protocol
+  private def value(index: Int): BigInt = {
+    val highBit = BigInt(1) << (bitWidth - 1)
+    highBit | (BigInt(index) & (highBit - 1))
+  }
+
+  @Setup(Level.Trial)
+  def compile(): Unit = {
+    val workspace = Designs.passthroughWorkspace(
+      s"test_run_dir/${getClass().getSimpleName()}-$portCount-$bitWidth",
+      portCount,
+      bitWidth
+    )
+    simulation = Designs.compile(workspace)
+  }
+
+  @Benchmark
+  @OperationsPerInvocation(SimulationBenchmarks.OperationCount)
+  def pokes(): Unit = simulation.run { controller =>
+    val ports = (0 until portCount).map { index => controller.port(s"in_$index") }
+    var operation = 0
+    while (operation < OperationCount) {
+      ports(operation % portCount).set(value(operation))
+      operation += 1
+    }
+    controller.completeInFlightCommands()
+  }
+
+  @Benchmark
+  @OperationsPerInvocation(SimulationBenchmarks.OperationCount)
+  def peeks(): Unit = simulation.run { controller =>
+    val ports = (0 until portCount).map { index => controller.port(s"in_$index") }
+    ports.foreach(_.set(value(0)))
+    var operation = 0
+    while (operation < OperationCount) {
+      // `check` is pipelined, which is the idiomatic way to read values in svsim
+      ports(operation % portCount).check { _ => }
+      operation += 1
+    }
+    controller.completeInFlightCommands()
+  }
+
+  @Benchmark
+  @OperationsPerInvocation(SimulationBenchmarks.OperationCount)
+  def ticks(): Unit = simulation.run { controller =>
+    controller.port("verbose").set(0)
+    controller
+      .port("clock")
+      .tick(
+        timestepsPerPhase = 1,
+        maxCycles = OperationCount,
+        inPhaseValue = 0,
+        outOfPhaseValue = 1,
+        sentinel = None
+      )
+  }
+
+  @Benchmark
+  @OperationsPerInvocation(SimulationBenchmarks.OperationCount)
+  def logRetrieval(): Unit = simulation.run { controller =>
+    controller.port("verbose").set(1)
+    controller
+      .port("clock")
+      .tick(
+        timestepsPerPhase = 1,
+        maxCycles = OperationCount,
+        inPhaseValue = 0,
+        outOfPhaseValue = 1,
+        sentinel = None
+      )
+    controller.readLog()
+  }
+}
+
+/** Measures the time to launch a simulation process and shut it down without doing any work.
+  */
+@State(Scope.Benchmark)
+@BenchmarkMode(Array(Mode.AverageTime))
+@OutputTimeUnit(TimeUnit.MILLISECONDS)
+@Warmup(iterations = 2)
+@Measurement(iterations = 5)
+@Fork(1)
+class ProcessStartupBenchmark {
+  @Param(Array("1", "64"))
+  var portCount: Int = _
+
+  var simulation: Simulation = _
+
+  @Setup(Level.Trial)
+  def compile(): Unit = {
+    val workspace = Designs.passthroughWorkspace(s"test_run_dir/${getClass().getSimpleName()}-$portCount", portCount, 8)
+    simulation = Designs.compile(workspace)
+  }
+
+  @Benchmark
+  def startup(): Unit = simulation.run { _ => }
+}
+
+/** Measures the time to compile a simulation from scratch, including harness generation.
+  */
+@State(Scope.Benchmark)
+@BenchmarkMode(Array(Mode.SingleShotTime))
+@OutputTimeUnit(TimeUnit.SECONDS)
+@Warmup(iterations = 1)
+@Measurement(iterations = 3)
+@Fork(1)
+class CompilationBenchmark {
+  @Param(Array("1", "64", "1024"))
+  var portCount: Int = _
+
+  @Param(Array("8", "1024"))
+  var bitWidth: Int = _
+
+  @Benchmark
+  def compile(): Simulation = {
+    val workspace = Designs.passthroughWorkspace(
+      s"test_run_dir/${getClass().getSimpleName()}-$portCount-$bitWidth",
+      portCount,
+      bitWidth
+    )
+    Designs.compile(workspace)
+  }
+}
@@ -34,8 +34,11 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <signal.h>
 #include <strings.h>
 #include <sys/personality.h>
+#include <sys/time.h>
+#include <time.h>
 #include <unistd.h>
 
 #ifdef SVSIM_ENABLE_VERILATOR_SUPPORT
@@ -48,6 +51,8 @@
 #define DPI_TASK_RETURN_TYPE void
 #define DPI_TASK_RETURN_VALUE
 #endif
+// Both backends provide the standard DPI header
+#include "svdpi.h"
 
 extern "C" {
 
@@ -97,6 +102,20 @@ enum {
   // Sent in response to the LOG command. The length of the log is provided
   // since it may contain newlines.
   MESSAGE_LOG = 'l',
+
+  // Format: h <cycles> <cycles per second>
+  // Sent periodically while a TICK command is running, if enabled by the
+  // HEARTBEAT command. Reports the number of cycles elapsed so far in the
+  // current TICK command, and the average number of cycles per second since it
+  // started. Heartbeats are sent in addition to the response to the command.
+  MESSAGE_HEARTBEAT = 'h',
+
+  // Format: w <cycles>
+  // Sent instead of a BITS message in response to a TICK command which ran for
+  // longer than the limit set by the WATCHDOG command, with the number of
+  // cycles elapsed before the command was stopped. The simulation can continue
+  // to be used after this message.
+  MESSAGE_WATCHDOG = 'w',
 };
 
 // Commands are read by this executable from `stdin`
@@ -126,7 +145,8 @@ enum {
   COMMAND_RUN = 'R',
 
   // Format: T <ticking port id> <in-phase value>,<out-of-phase
-  // value>-<timesteps>*<max cycles>[ <sentinel port id> <sentinel value>]
+  // value>-<timesteps>*<max cycles>[ <sentinel port id> <sentinel value>][
+  // ~<quiescent cycles>@<watched port ids>]
   // Runs the simulation for at most the specified number of cycles. A cycle is
   // defined as setting the ticking port to the "in-phase" state, running the
   // simulation for the specified number of timesteps, then setting the ticking
@@ -135,6 +155,16 @@ enum {
   // number of timesteps).
   // If a sentinel port and value are provided, the simulation will stop early
   // if the sentinel port is set to the specified value.
+  // Optionally, the command may end with a quiescence clause of the form
+  // ` ~<quiescent cycles>@<watched port id>[,<watched port id>...]`. If the
+  // values of all watched ports are unchanged for the specified number of
+  // consecutive cycles (and the sentinel has not been reached), the design is
+  // assumed to have reached a fixed point, and the remaining cycles are skipped
+  // by advancing simulation time without toggling the ticking port. This is
+  // only correct if the watched ports cover all of the state which can change
+  // while the design is idle, and the design's inputs are held constant.
+  // Returns a BITS message with the number of cycles elapsed, including any
+  // which were skipped.
   COMMAND_TICK = 'T',
 
   // Format: X [1|0]
@@ -143,6 +173,29 @@ enum {
   // proper arguments are passed to the compiler, including the desired
   // SVSIM_ENABLE_*_TRACING define.
   COMMAND_TRACE = 'W',
+
+  // Format: A <lane>
+  // Selects the lane which subsequent commands apply to. When the simulation
+  // is launched with `SVSIM_LANE_COUNT` set to a value greater than 1, the
+  // driver instantiates that many independent copies of the testbench (lanes)
+  // in this process, each with its own simulation time. Commands other than
+  // DONE and LOG apply only to the selected lane, which is lane 0 on startup.
+  // Returns an ACK message.
+  COMMAND_SELECT_LANE = 'A',
+
+  // Format: H <interval in milliseconds>
+  // Enables HEARTBEAT messages at the specified interval while TICK commands
+  // are running. An interval of 0 disables heartbeats. Returns an ACK message.
+  COMMAND_HEARTBEAT = 'H',
+
+  // Format: M <limit in milliseconds>
+  // Limits the wall-clock time of subsequent commands. A TICK command which
+  // exceeds the limit is stopped early and returns a WATCHDOG message. Other
+  // commands cannot be stopped early (for instance, RUN is a single call into
+  // the simulator), so if any command takes more than twice the limit an ERROR
+  // message is sent and the simulation exits. A limit of 0 disables the
+  // watchdog. Returns an ACK message.
+  COMMAND_WATCHDOG = 'M',
 };
 
 /**
@@ -268,11 +321,81 @@ static void sendUintAsBits(uint64_t value) {
   sendBits((uint8_t *)&value, sizeof(uint64_t) * 8, false);
 }
 
+// -- Binary printf
+
+/**
+ * Printfs which Chisel lowers to binary records (see `BinaryPrintfAnnotation`)
+ * call these DPI functions instead of formatting their message with `$fwrite`.
+ * Each record is the printf's id, the number of words of its arguments, and
+ * those words, all as 32-bit values in the byte order of the host (which the
+ * decoder, `BinaryPrintfDecoder`, expects to be little-endian). Records are
+ * appended to a buffer which is written to the file at `SVSIM_BINARY_PRINTF`
+ * when it is full, when a LOG command is received, and when the simulation
+ * exits, so that the eval loop only copies the values of arguments. Records
+ * from all lanes are written to the same file, which is only created when the
+ * first records are written.
+ */
+// `binaryPrintfPath` is set in `main`
+static const char *binaryPrintfPath = NULL;
+static FILE *binaryPrintfFile = NULL;
+static uint32_t binaryPrintfBuffer[1 << 16];
+static size_t binaryPrintfBufferCount = 0;
+
+static bool writeBinaryPrintfBuffer() {
+  size_t count = binaryPrintfBufferCount;
+  binaryPrintfBufferCount = 0;
+  if (count == 0) {
+    return true;
+  }
+  if (binaryPrintfFile == NULL) {
+    binaryPrintfFile = fopen(binaryPrintfPath, "wb");
+    if (binaryPrintfFile == NULL) {
+      return false;
+    }
+  }
+  return fwrite(binaryPrintfBuffer, sizeof(uint32_t), count,
+                binaryPrintfFile) == count &&
+         fflush(binaryPrintfFile) == 0;
+}
+
+static void flushBinaryPrintf() {
+  if (!writeBinaryPrintfBuffer()) {
+    failWithError("Failed to write binary printf records to %s.",
+                  binaryPrintfPath);
+  }
+}
+
+/// `exit` must not be called again while exiting, so only report the error
+static void flushBinaryPrintfOnExit() {
+  if (!writeBinaryPrintfBuffer()) {
+    writeMessage(MESSAGE_ERROR, "Failed to write binary printf records to %s.",
+                 binaryPrintfPath);
+  }
+}
+
+static inline void appendBinaryPrintfWord(uint32_t word) {
+  if (binaryPrintfBufferCount ==
+      sizeof(binaryPrintfBuffer) / sizeof(binaryPrintfBuffer[0])) {
+    flushBinaryPrintf();
+  }
+  binaryPrintfBuffer[binaryPrintfBufferCount++] = word;
+}
+
+void chisel_binary_printf_begin(int id, int words) {
+  appendBinaryPrintfWord((uint32_t)id);
+  appendBinaryPrintfWord((uint32_t)words);
+}
+
+void chisel_binary_printf_word(int word) {
+  appendBinaryPrintfWord((uint32_t)word);
+}
+
 // `logFilePath` is set in `main`
 const char *logFilePath = NULL;
 static void sendLog() {
   /// `stdout` is a file and needs to be flushed so that the log is present
   fflush(stdout);
+  flushBinaryPrintf();
 
   /// RUN responds with a LOG message and the currently logged data
   static FILE *log = NULL;
@@ -567,6 +690,76 @@ static void resolveGettablePort(int id, GettablePort *out,
   }
 }
 
+// -- Lanes
+
+/**
+ * Each lane is a separate instance of the testbench. `simulation_body` is
+ * called once by each lane as it initializes, which allows us to capture the
+ * DPI scope of that lane. DPI-exported functions (like port getters and
+ * setters) are then directed to the selected lane by setting the DPI scope.
+ * Lanes are only ever evaluated by the driver's command loop, one at a time,
+ * and never from within another lane's evaluation.
+ */
+int laneCount = 1;
+int initializingLane = 0;
+int selectedLane = 0;
+static svScope *laneScopes = NULL;
+
+static void enterSelectedLaneScope() { svSetScope(laneScopes[selectedLane]); }
+
+// -- Heartbeat and Watchdog
+
+/**
+ * The wall clock is only consulted every `wallClockCheckInterval` cycles of a
+ * TICK command, so that heartbeats and the watchdog have a negligible effect on
+ * the simulation's throughput.
+ */
+static const int wallClockCheckInterval = 64;
+static long heartbeatIntervalMillis = 0;
+static long watchdogLimitMillis = 0;
+static int watchdogMessageFileDescriptor = -1;
+
+/**
+ * Heartbeats are sent at times which depend on the wall clock, so unlike other
+ * messages they are neither numbered nor logged to the execution script, which
+ * would otherwise no longer replay deterministically.
+ */
+static void sendHeartbeat(int cycles, long long cyclesPerSecond) {
+  fprintf(messageStream, "%c %X %llX\n", MESSAGE_HEARTBEAT, cycles,
+          cyclesPerSecond);
+  fflush(messageStream);
+}
+
+static long long currentTimeMillis() {
+  struct timespec time;
+  clock_gettime(CLOCK_MONOTONIC, &time);
+  return (long long)time.tv_sec * 1000 + time.tv_nsec / 1000000;
+}
+
+static void watchdogTimerExpired(int) {
+  // Only async-signal-safe functions may be called here
+  static const char message[] =
+      "e Watchdog expired: command did not complete within twice the time "
+      "limit.\n";
+  ssize_t result =
+      write(watchdogMessageFileDescriptor, message, sizeof(message) - 1);
+  (void)result;
+  _exit(EXIT_FAILURE);
+}
+
+/**
+ * Arms (or, with a limit of 0, disarms) a timer which terminates the
+ * simulation if a command runs for twice the watchdog limit without
+ * completing. This catches commands which cannot be stopped cooperatively.
+ */
+static void setWatchdogTimer(long limitMillis) {
+  struct itimerval timer;
+  memset(&timer, 0, sizeof(timer));
+  timer.it_value.tv_sec = (2 * limitMillis) / 1000;
+  timer.it_value.tv_usec = ((2 * limitMillis) % 1000) * 1000;
+  setitimer(ITIMER_REAL, &timer, NULL);
+}
+
 // -- Processing Commands
 
 const char *simulationTraceFilepath = NULL;
@@ -576,6 +769,11 @@ static void processCommand() {
   const char *lineCursor = NULL;
   const char *lineEnd = NULL;
   readCommand(&lineCursor, &lineEnd);
+  long long commandStartTimeMillis = currentTimeMillis();
+  bool watchdogTimerArmed = watchdogLimitMillis > 0;
+  if (watchdogTimerArmed) {
+    setWatchdogTimer(watchdogLimitMillis);
+  }
 
   char commandCode = *(lineCursor++);
   switch (commandCode) {
@@ -600,6 +798,7 @@ static void processCommand() {
     const char *valueStart = lineCursor;
     uint8_t *data = scanHexBits(&valueStart, lineEnd, port.bitWidth,
                                 "parsing value for SET_BITS command");
+    enterSelectedLaneScope();
     (*port.setter)(data);
     free(data);
 
@@ -641,6 +840,7 @@ static void processCommand() {
     int byteCount = (port.bitWidth + 7) / 8;
     uint8_t *bytes = (uint8_t *)calloc(sizeof(uint8_t), byteCount);
     assert(bytes != NULL);
+    enterSelectedLaneScope();
     (*port.getter)(bytes);
     sendBits(bytes, port.bitWidth, isSigned);
     free(bytes);
@@ -659,7 +859,8 @@ static void processCommand() {
   case COMMAND_TICK: {
     // T <ticking-port-ID>
     // <in-phase-value>,<out-of-phase-value>-<timesteps-per-phase>*<max-cycle-count>[
-    // <sentinel-port-ID>=<sentinel-value>]
+    // <sentinel-port-ID>=<sentinel-value>][
+    // ~<quiescent-cycle-count>@<watched-port-ID>[,<watched-port-ID>...]]
 
     uint32_t tickingPortID =
         scanInt(&lineCursor, "parsing ticking port ID for TICK command");
@@ -702,7 +903,7 @@ static void processCommand() {
     uint8_t *sentinelValue = NULL;
     uint8_t *sentinelPortValue = NULL;
     int sentinelPortByteCount = 0;
-    if (*lineCursor == ' ') {
+    if (lineCursor[0] == ' ' && lineCursor[1] != '~') {
       lineCursor++;
       uint32_t sentinelPortID =
           scanInt(&lineCursor, "parsing sentinel port ID for TICK command");
@@ -712,8 +913,13 @@ static void processCommand() {
         failWithError(
             "Expected equals sign after sentinel port ID for TICK command.");
       }
-      sentinelValue = scanHexBits(&lineCursor, lineEnd, sentinelPort.bitWidth,
-                                  "parsing sentinel value for TICK command");
+      const char *sentinelValueEnd = findNext(lineCursor, ' ');
+      if (sentinelValueEnd > lineEnd) {
+        sentinelValueEnd = lineEnd;
+      }
+      sentinelValue =
+          scanHexBits(&lineCursor, sentinelValueEnd, sentinelPort.bitWidth,
+                      "parsing sentinel value for TICK command");
 
       sentinelPortByteCount = (sentinelPort.bitWidth + 7) / 8;
       sentinelPortValue =
@@ -721,12 +927,79 @@ static void processCommand() {
       assert(sentinelPortValue != NULL);
     }
 
+    int quiescentCycleThreshold = 0;
+    int watchedPortCount = 0;
+    GettablePort *watchedPorts = NULL;
+    int watchedByteCount = 0;
+    uint8_t *watchedValues = NULL;
+    uint8_t *previousWatchedValues = NULL;
+    if (lineCursor[0] == ' ' && lineCursor[1] == '~') {
+      lineCursor += 2;
+      quiescentCycleThreshold = scanInt(
+          &lineCursor, "parsing quiescent cycle count for TICK command");
+      if (quiescentCycleThreshold <= 0) {
+        failWithError("Quiescent cycle count for TICK command should be "
+                      "greater than 0.");
+      }
+      if (*(lineCursor++) != '@') {
+        failWithError(
+            "Expected at sign after quiescent cycle count for TICK command.");
+      }
+
+      watchedPortCount = 1;
+      for (const char *cursor = lineCursor; cursor < lineEnd; cursor++) {
+        if (*cursor == ',') {
+          watchedPortCount++;
+        }
+      }
+      watchedPorts =
+          (GettablePort *)calloc(sizeof(GettablePort), watchedPortCount);
+      assert(watchedPorts != NULL);
+      for (int index = 0; index < watchedPortCount; index++) {
+        if (index > 0 && *(lineCursor++) != ',') {
+          failWithError("Expected comma between watched port IDs for TICK "
+                        "command.");
+        }
+        uint32_t watchedPortID = scanInt(
+            &lineCursor, "parsing watched port ID for TICK command");
+        resolveGettablePort(watchedPortID, &watchedPorts[index],
+                            "resolving watched port for TICK command");
+        watchedByteCount += (watchedPorts[index].bitWidth + 7) / 8;
+      }
+      watchedValues = (uint8_t *)calloc(sizeof(uint8_t), watchedByteCount);
+      assert(watchedValues != NULL);
+      previousWatchedValues =
+          (uint8_t *)calloc(sizeof(uint8_t), watchedByteCount);
+      assert(previousWatchedValues != NULL);
+    }
+
     if (*lineCursor != '\n') {
       failWithError("Unexpected data at end of TICK command: %s.", lineCursor);
     }
 
+    enterSelectedLaneScope();
     int cycles = 0;
+    int quiescentCycles = 0;
+    bool watchdogExpired = false;
+    long long nextHeartbeatTimeMillis =
+        commandStartTimeMillis + heartbeatIntervalMillis;
     while (cycles++ < maxCycleCount) {
+      if ((heartbeatIntervalMillis > 0 || watchdogLimitMillis > 0) &&
+          cycles % wallClockCheckInterval == 0) {
+        long long now = currentTimeMillis();
+        long long elapsedMillis = now - commandStartTimeMillis;
+        if (heartbeatIntervalMillis > 0 && now >= nextHeartbeatTimeMillis) {
+          long long cyclesPerSecond =
+              elapsedMillis > 0 ? (cycles - 1) * 1000LL / elapsedMillis : 0;
+          sendHeartbeat(cycles - 1, cyclesPerSecond);
+          nextHeartbeatTimeMillis = now + heartbeatIntervalMillis;
+        }
+        if (watchdogLimitMillis > 0 && elapsedMillis >= watchdogLimitMillis) {
+          watchdogExpired = true;
+          break;
+        }
+      }
+
       if (sentinelPort.getter != NULL) {
         (*sentinelPort.getter)(sentinelPortValue);
         if (memcmp(sentinelPortValue, sentinelValue, sentinelPort.bitWidth) ==
@@ -735,6 +1008,40 @@ static void processCommand() {
         }
       }
 
+      if (watchedPorts != NULL) {
+        uint8_t *watchedValue = watchedValues;
+        for (int index = 0; index < watchedPortCount; index++) {
+          (*watchedPorts[index].getter)(watchedValue);
+          watchedValue += (watchedPorts[index].bitWidth + 7) / 8;
+        }
+        if (cycles > 1 && memcmp(watchedValues, previousWatchedValues,
+                                 watchedByteCount) == 0) {
+          quiescentCycles++;
+        } else {
+          quiescentCycles = 0;
+        }
+        uint8_t *swap = previousWatchedValues;
+        previousWatchedValues = watchedValues;
+        watchedValues = swap;
+
+        if (quiescentCycles >= quiescentCycleThreshold) {
+          // The design is at a fixed point, so the remaining cycles (including
+          // this one) would not change anything other than simulation time.
+          // Time is advanced in chunks since it may not fit in an `int`.
+          long long remainingTimesteps =
+              2LL * timestepsPerPhase * (maxCycleCount - cycles + 1);
+          while (remainingTimesteps > 0) {
+            int timesteps = remainingTimesteps > INT_MAX
+                                ? INT_MAX
+                                : (int)remainingTimesteps;
+            run_simulation(timesteps);
+            remainingTimesteps -= timesteps;
+          }
+          cycles = maxCycleCount + 1;
+          break;
+        }
+      }
+
       (*tickingPort.setter)(inPhaseValue);
       run_simulation(timestepsPerPhase);
       (*tickingPort.setter)(outOfPhaseValue);
@@ -742,7 +1049,11 @@ static void processCommand() {
     }
 
     cycles--; // Consume the unbalanced increment from the while condition
-    sendUintAsBits(cycles);
+    if (watchdogExpired) {
+      writeMessage(MESSAGE_WATCHDOG, "%X", cycles);
+    } else {
+      sendUintAsBits(cycles);
+    }
 
     free(inPhaseValue);
     free(outOfPhaseValue);
@@ -750,10 +1061,19 @@ static void processCommand() {
       free(sentinelValue);
     if (sentinelPortValue != NULL)
       free(sentinelPortValue);
+    if (watchedPorts != NULL) {
+      free(watchedPorts);
+      free(watchedValues);
+      free(previousWatchedValues);
+    }
     break;
   }
   case COMMAND_TRACE: {
-    static bool traceInitialized = false;
+    static bool *traceInitialized = NULL;
+    if (traceInitialized == NULL) {
+      traceInitialized = (bool *)calloc(sizeof(bool), laneCount);
+      assert(traceInitialized != NULL);
+    }
 
     if (*(lineCursor++) != ' ') {
       failWithError("Expected space after ticking port ID for TICK command.");
@@ -765,11 +1085,23 @@ static void processCommand() {
       failWithError("Unexpected data at end of TRACE command.");
     }
 
+    enterSelectedLaneScope();
     switch (argument) {
     case '1':
-      if (!traceInitialized) {
-        traceInitialized = true;
-        simulation_initializeTrace(simulationTraceFilepath);
+      if (!traceInitialized[selectedLane]) {
+        traceInitialized[selectedLane] = true;
+        if (selectedLane == 0) {
+          simulation_initializeTrace(simulationTraceFilepath);
+        } else {
+          // Each lane after the first writes to its own trace file
+          size_t laneTraceFilepathLength = strlen(simulationTraceFilepath) + 32;
+          char *laneTraceFilepath = (char *)malloc(laneTraceFilepathLength);
+          assert(laneTraceFilepath != NULL);
+          snprintf(laneTraceFilepath, laneTraceFilepathLength, "%s-lane%d",
+                   simulationTraceFilepath, selectedLane);
+          simulation_initializeTrace(laneTraceFilepath);
+          free(laneTraceFilepath);
+        }
       }
       simulation_enableTrace();
       break;
@@ -781,9 +1113,75 @@ static void processCommand() {
     sendAck();
     break;
   }
+  case COMMAND_SELECT_LANE: {
+    if (*(lineCursor++) != ' ') {
+      failWithError("Expected space after SELECT_LANE command.");
+    }
+    int lane = scanInt(&lineCursor, "parsing lane for SELECT_LANE command");
+    if (*lineCursor != '\n') {
+      failWithError("Unexpected data at end of SELECT_LANE command.");
+    }
+    if (lane < 0 || lane >= laneCount) {
+      failWithError("Lane %d is out of range (lane count is %d).", lane,
+                    laneCount);
+    }
+    selectedLane = lane;
+
+    sendAck();
+    break;
+  }
+  case COMMAND_HEARTBEAT: {
+    if (*(lineCursor++) != ' ') {
+      failWithError("Expected space after HEARTBEAT command.");
+    }
+    int interval =
+        scanInt(&lineCursor, "parsing interval for HEARTBEAT command");
+    if (*lineCursor != '\n') {
+      failWithError("Unexpected data at end of HEARTBEAT command.");
+    }
+    if (interval < 0) {
+      failWithError("Heartbeat interval should not be negative.");
+    }
+    heartbeatIntervalMillis = interval;
+
+    sendAck();
+    break;
+  }
+  case COMMAND_WATCHDOG: {
+    if (*(lineCursor++) != ' ') {
+      failWithError("Expected space after WATCHDOG command.");
+    }
+    int limit = scanInt(&lineCursor, "parsing limit for WATCHDOG command");
+    if (*lineCursor != '\n') {
+      failWithError("Unexpected data at end of WATCHDOG command.");
+    }
+    if (limit < 0) {
+      failWithError("Watchdog limit should not be negative.");
+    }
+    if (watchdogMessageFileDescriptor == -1) {
+      watchdogMessageFileDescriptor = fileno(messageStream);
+      signal(SIGALRM, watchdogTimerExpired);
+    }
+    watchdogLimitMillis = limit;
+
+    sendAck();
+    break;
+  }
   default:
     failWithError("Unknown opcode '%d'.", commandCode);
   }
+
+  if (watchdogTimerArmed) {
+    setWatchdogTimer(0);
+  }
+}
+
+static void runCommandLoop() {
+  /// If we have made it to the command loop, there were no errors on startup
+  /// and the first thing we do is send a READY message.
+  sendReady();
+  while (!receivedDone)
+    processCommand();
 }
 
 bool aslrShenanigansDetected = false;
@@ -792,11 +1190,15 @@ DPI_TASK_RETURN_TYPE simulation_body() {
     failWithError("Backend did not relaunch the executable with ASLR disabled "
                   "as expected.");
   }
-  /// If we have made it to `simulation_body`, there were no errors on startup
-  /// and the first thing we do is send a READY message.
-  sendReady();
-  while (!receivedDone)
-    processCommand();
+  laneScopes[initializingLane] = svGetScope();
+#ifndef SVSIM_ENABLE_VERILATOR_SUPPORT
+  /// VCS advances time with `#delay` in `run_simulation`, which may only be
+  /// called from within the initial block, so the command loop runs here. With
+  /// Verilator, `simulation_main` runs the command loop once every lane has
+  /// finished its initial evaluation, so that no lane is evaluated from within
+  /// this DPI call.
+  runCommandLoop();
+#endif
   return DPI_TASK_RETURN_VALUE;
 }
 
@@ -840,6 +1242,29 @@ int main(int argc, const char *argv[]) {
     failWithError("Failed to redirect stdout to %s.", logFilePath);
   }
 
+  binaryPrintfPath = getenv("SVSIM_BINARY_PRINTF");
+  if (binaryPrintfPath == NULL) {
+    binaryPrintfPath = "binary-printf.bin";
+  }
+  /// VCS's `simulation_main` never returns, so records are flushed on exit
+  atexit(flushBinaryPrintfOnExit);
+
+  const char *laneCountString = getenv("SVSIM_LANE_COUNT");
+  if (laneCountString != NULL) {
+    long value = strtol(laneCountString, NULL, 10);
+    if (value < 1 || value > INT_MAX) {
+      failWithError("Invalid lane count '%ld'.", value);
+    }
+    laneCount = (int)value;
+  }
+#ifndef SVSIM_ENABLE_VERILATOR_SUPPORT
+  if (laneCount != 1) {
+    failWithError("Multiple lanes are only supported by the Verilator backend.");
+  }
+#endif
+  laneScopes = (svScope *)calloc(sizeof(svScope), laneCount);
+  assert(laneScopes != NULL);
+
   simulationTraceFilepath = getenv("SVSIM_SIMULATION_TRACE");
   if (simulationTraceFilepath == NULL) {
     simulationTraceFilepath = "trace";
@@ -881,33 +1306,49 @@ int main(int argc, const char *argv[]) {
 
 extern "C" {
 
-static VerilatedContext *context;
-static VsvsimTestbench *testbench;
+// Each lane has its own context, so that each lane has its own simulation time
+static VerilatedContext **contexts;
+static VsvsimTestbench **testbenches;
 
 void simulation_main(int argc, char const **argv) {
-  context = new VerilatedContext;
-  context->debug(0);
+  contexts = new VerilatedContext *[laneCount];
+  testbenches = new VsvsimTestbench *[laneCount];
+  for (int lane = 0; lane < laneCount; lane++) {
+    VerilatedContext *context = new VerilatedContext;
+    context->debug(0);
 
 #ifdef SVSIM_VERILATOR_TRACE_ENABLED
-  context->traceEverOn(true);
+    context->traceEverOn(true);
 #endif
 
-  context->commandArgs(argc, argv);
-  testbench = new VsvsimTestbench{context};
+    context->commandArgs(argc, argv);
+    contexts[lane] = context;
+    testbenches[lane] = new VsvsimTestbench{context};
+  }
 
-  // Evaluate initial state which should call `simulation_body` via DPI and
-  // start the command loop.
-  testbench->eval();
+  // Evaluate initial state which should call `simulation_body` via DPI,
+  // capturing each lane's scope.
+  for (int lane = 0; lane < laneCount; lane++) {
+    initializingLane = lane;
+    testbenches[lane]->eval();
+  }
 
-  testbench->final();
+  // Each `run_simulation` evaluates the selected lane from the command loop,
+  // outside of any lane's evaluation.
+  runCommandLoop();
 
-  delete testbench;
-  delete context;
+  for (int lane = 0; lane < laneCount; lane++) {
+    testbenches[lane]->final();
+    delete testbenches[lane];
+    delete contexts[lane];
+  }
+  delete[] testbenches;
+  delete[] contexts;
 }
 
 void run_simulation(int delay) {
-  testbench->eval();
-  context->timeInc(delay);
+  testbenches[selectedLane]->eval();
+  contexts[selectedLane]->timeInc(delay);
 }
 
 } // extern "C"
@@ -11,7 +11,8 @@ case class CommonCompilationSettings(
     CommonCompilationSettings.AvailableParallelism.Default,
   defaultTimescale:  Option[CommonCompilationSettings.Timescale] = None,
   libraryExtensions: Option[Seq[String]] = None,
-  libraryPaths:      Option[Seq[String]] = None)
+  libraryPaths:      Option[Seq[String]] = None,
+  simulationCache:   Option[CommonCompilationSettings.SimulationCache] = None)
 object CommonCompilationSettings {
   object VerilogPreprocessorDefine {
     def apply(name: String, value: String) = new VerilogPreprocessorDefine(name, Some(value))
@@ -48,8 +49,19 @@ object CommonCompilationSettings {
     /** Use up to specified number of parallel processes.
       */
     case class UpTo(value: Int) extends AvailableParallelism
+
+    /** Share a budget of `maxJobs` parallel processes between all compilations on this machine which use the same `slotDirectory`, including compilations launched by other processes. Like a GNU make jobserver, each job claims a slot only while it runs: the Verilator backend claims one slot per C++ compiler invocation, and the VCS backend one slot for the whole compilation. This avoids oversubscribing the machine when many test processes compile simulations concurrently, while letting each compilation use the whole budget when it is the only one running. Slots are claimed using `flock`, and are not enforced where it is unavailable.
+      */
+    case class SharedAcrossProcesses(
+      maxJobs:       Int = Runtime.getRuntime().availableProcessors(),
+      slotDirectory: String = s"${System.getProperty("java.io.tmpdir")}/svsim-job-slots-${System.getProperty("user.name")}")
+        extends AvailableParallelism
   }
 
+  /** Reuse compiled simulations stored in `path` when the sources and compilation settings are unchanged, and store newly compiled simulations there. This is only supported by backends which compile the simulation into a single self-contained executable (currently Verilator), and is ignored by other backends.
+    */
+  case class SimulationCache(path: String)
+
   val default = CommonCompilationSettings()
 
   sealed trait Timescale
@@ -60,13 +72,28 @@ object CommonCompilationSettings {
 
 trait Backend {
   type CompilationSettings
+  /** @param workspacePath The root of the workspace, which contains the working directory in which the compiler is invoked.
+    */
   private[svsim] def invocationSettings(
+    workspacePath:           String,
     outputBinaryName:        String,
     topModuleName:           String,
     additionalHeaderPaths:   Seq[String],
     commonSettings:          CommonCompilationSettings,
     backendSpecificSettings: CompilationSettings
   ): Backend.InvocationSettings
+
+  /** Extracts timings of the internal phases of compilation (for instance, C++ compilation) from the compiler's output, for backends whose compiler reports them. Phase names are relative to the phase in which the compiler was invoked.
+    */
+  private[svsim] def compilationPhaseTimings(compilationLog: Seq[String]): Seq[PhaseTiming] = Seq()
+
+  /** Reads numeric statistics about the compiled design (for instance, the number of nodes after optimization) which the compiler wrote to the working directory, for backends which were configured to report them.
+    */
+  private[svsim] def compilationStatistics(workingDirectoryPath: String): Seq[(String, Double)] = Seq()
+
+  /** The version of the backend's tools, for backends whose compiled simulation is a single self-contained executable which can be stored in a `CommonCompilationSettings.SimulationCache`. Backends which return `None` do not support caching.
+    */
+  private[svsim] def simulationCacheVersion: Option[String] = None
 }
 
 object Backend {
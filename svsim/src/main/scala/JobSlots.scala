@@ -0,0 +1,66 @@
+// SPDX-License-Identifier: Apache-2.0
+
+package svsim
+
+import java.io.File
+import java.nio.charset.StandardCharsets
+import java.nio.file.{Files, StandardCopyOption}
+
+/** A machine-wide pool of job slots shared by all svsim compilations, in the style of a GNU make jobserver: each job (for instance, each C++ compiler invocation of a Verilator build) claims one slot for as long as it runs.
+  *
+  * Slots are files in a shared directory, claimed by a wrapper script using `flock`. Locks are released by the operating system when the job exits, even if it crashes, so slots can never leak. If `flock` is not available (for instance, on macOS), jobs run without claiming a slot.
+  */
+private[svsim] object JobSlots {
+
+  /** The environment variables which configure the wrapper script.
+    *
+    * @param command a command which is prefixed to each job, such as a compiler cache
+    */
+  def environment(maxJobs: Int, slotDirectory: String, command: Option[String] = None): Seq[(String, String)] = {
+    require(maxJobs > 0, "maxJobs must be greater than 0")
+    Seq(
+      "SVSIM_JOB_SLOTS" -> slotDirectory,
+      "SVSIM_MAX_JOBS" -> maxJobs.toString()
+    ) ++ command.map("SVSIM_JOB_COMMAND" -> _)
+  }
+
+  private val script =
+    """#!/bin/sh
+      |# Runs a command while holding one of the `SVSIM_MAX_JOBS` job slots in `SVSIM_JOB_SLOTS`, prefixed by
+      |# `SVSIM_JOB_COMMAND` if it is set. This script is generated by svsim.
+      |if command -v flock >/dev/null 2>&1; then
+      |  while :; do
+      |    slot=0
+      |    while [ "$slot" -lt "$SVSIM_MAX_JOBS" ]; do
+      |      exec 9>>"$SVSIM_JOB_SLOTS/slot-$slot"
+      |      if flock -n 9; then
+      |        # The command does not inherit the lock, which is released when this script exits
+      |        $SVSIM_JOB_COMMAND "$@" 9>&-
+      |        exit $?
+      |      fi
+      |      exec 9>&-
+      |      slot=$((slot + 1))
+      |    done
+      |    sleep 0.05
+      |  done
+      |fi
+      |exec $SVSIM_JOB_COMMAND "$@"
+      |""".stripMargin
+
+  /** Writes the wrapper script to `slotDirectory`, if it is not already there, and returns its path.
+    */
+  def wrapperPath(slotDirectory: String): String = {
+    val directory = new File(slotDirectory)
+    directory.mkdirs()
+    val wrapper = new File(directory, "run-in-job-slot")
+    val bytes = script.getBytes(StandardCharsets.UTF_8)
+    if (!wrapper.exists() || !java.util.Arrays.equals(Files.readAllBytes(wrapper.toPath()), bytes)) {
+      // Concurrent processes may write the wrapper at the same time, so it is written to a unique file and then moved into place atomically
+      val temporary = File.createTempFile("run-in-job-slot", ".tmp", directory)
+      Files.write(temporary.toPath(), bytes)
+      temporary.setExecutable(true)
+      Files.move(temporary.toPath(), wrapper.toPath(), StandardCopyOption.REPLACE_EXISTING, StandardCopyOption.ATOMIC_MOVE)
+    }
+    wrapper.getAbsolutePath()
+  }
+}
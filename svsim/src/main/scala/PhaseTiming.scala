@@ -0,0 +1,78 @@
+// SPDX-License-Identifier: Apache-2.0
+
+package svsim
+
+/** The wall-clock time, and where known the memory allocated, of a single phase of compiling or running a simulation.
+  *
+  * Phase names are hierarchical, with components separated by `/` (for example `compilation/verilator/cxx-build`), so that timings reported by different layers of the stack can be combined into a single report.
+  */
+final case class PhaseTiming(
+  name:          String,
+  durationNanos: Long,
+  /** The total number of bytes allocated during the phase, which is an upper bound on (and not the same as) the phase's peak memory usage. Allocations are reported by Verilator for its own phases, and are counted on the calling thread for JVM phases.
+    */
+  allocatedBytes: Option[Long] = None)
+
+object PhaseTiming {
+
+  /** Times `body`, reporting the result to `report` even if `body` throws.
+    */
+  def measure[T](name: String, report: PhaseTiming => Unit)(body: => T): T = {
+    val startTime = System.nanoTime()
+    try {
+      body
+    } finally {
+      report(PhaseTiming(name, System.nanoTime() - startTime))
+    }
+  }
+
+  /** Timings of the same phase aggregated across many compilations or simulations (for instance, all simulations in a test suite).
+    */
+  final case class Summary(
+    name:               String,
+    count:              Int,
+    totalDurationNanos: Long,
+    maxDurationNanos:   Long,
+    maxAllocatedBytes: Option[Long]) {
+    def meanDurationNanos: Long = totalDurationNanos / count
+  }
+
+  /** Aggregates timings by phase name, preserving the order in which each phase was first encountered.
+    */
+  def summarize(timings: Iterable[PhaseTiming]): Seq[Summary] = {
+    val summaries = scala.collection.mutable.LinkedHashMap.empty[String, Summary]
+    timings.foreach { timing =>
+      val summary = summaries.get(timing.name) match {
+        case None =>
+          Summary(timing.name, 1, timing.durationNanos, timing.durationNanos, timing.allocatedBytes)
+        case Some(previous) =>
+          Summary(
+            timing.name,
+            previous.count + 1,
+            previous.totalDurationNanos + timing.durationNanos,
+            math.max(previous.maxDurationNanos, timing.durationNanos),
+            (previous.maxAllocatedBytes ++ timing.allocatedBytes).reduceOption(math.max(_, _))
+          )
+      }
+      summaries(timing.name) = summary
+    }
+    summaries.values.toSeq
+  }
+
+  /** Renders summaries as tab-separated values with a header row, suitable for collecting across test runs.
+    */
+  def toTSV(summaries: Seq[Summary]): String = {
+    val header = Seq("phase", "count", "total_ns", "mean_ns", "max_ns", "max_allocated_bytes").mkString("\t")
+    val rows = summaries.map { summary =>
+      Seq(
+        summary.name,
+        summary.count.toString,
+        summary.totalDurationNanos.toString,
+        summary.meanDurationNanos.toString,
+        summary.maxDurationNanos.toString,
+        summary.maxAllocatedBytes.map(_.toString).getOrElse("")
+      ).mkString("\t")
+    }
+    (header +: rows).mkString("", "\n", "\n")
+  }
+}
@@ -2,6 +2,7 @@
 
 package svsim
 
+import scala.annotation.tailrec
 import scala.collection.mutable.Queue
 import java.io.{BufferedReader, BufferedWriter, File, InputStreamReader, OutputStreamWriter}
 
@@ -9,16 +10,29 @@ final class Simulation private[svsim] (
   executableName:           String,
   settings:                 Simulation.Settings,
   val workingDirectoryPath: String,
-  moduleInfo:               ModuleInfo) {
+  moduleInfo:               ModuleInfo,
+  /** Timings of the phases of `Workspace.compile` which produced this simulation.
+    */
+  val compilationPhaseTimings: Seq[PhaseTiming] = Seq(),
+  /** Statistics about the compiled design, for backends configured to report them (for instance, Verilator's `reportStatistics`). These are not available if the simulation was restored from a `SimulationCache`.
+    */
+  val compilationStatistics: Seq[(String, Double)] = Seq()) {
   private val executionScriptPath = s"$workingDirectoryPath/execution-script.txt"
 
   def run[T](body: Simulation.Controller => T): T = run()(body)
+
+  /** @param laneCount The number of independent copies ("lanes") of the testbench to instantiate in the simulation process. This allows running many independent stimuli (for instance, different random seeds) in a single process, sharing the cost of process startup and the memory for code. Use `Controller.selectLane` to choose which lane subsequent commands apply to. Multiple lanes are currently only supported by the Verilator backend.
+    * @param reportPhaseTiming Called with the timing of each phase of the simulation (startup, the body, and shutdown) as it completes, including phases which end in an error.
+    */
   def run[T](
     conservativeCommandResolution: Boolean = false,
     verbose:                       Boolean = false,
-    executionScriptLimit:          Option[Int] = None
+    executionScriptLimit:          Option[Int] = None,
+    laneCount:                     Int = 1,
+    reportPhaseTiming:             PhaseTiming => Unit = _ => ()
   )(body:                          Simulation.Controller => T
   ): T = {
+    require(laneCount > 0, "laneCount must be greater than 0")
     val cwd = settings.customWorkingDirectory match {
       case None => workingDirectoryPath
       case Some(value) =>
@@ -32,11 +46,13 @@ final class Simulation private[svsim] (
     processBuilder.directory(new File(cwd))
     val environment = settings.environment ++ Seq(
       Some("SVSIM_EXECUTION_SCRIPT" -> executionScriptPath),
-      executionScriptLimit.map("SVSIM_EXECUTION_SCRIPT_LIMIT" -> _.toString)
+      executionScriptLimit.map("SVSIM_EXECUTION_SCRIPT_LIMIT" -> _.toString),
+      Some("SVSIM_LANE_COUNT" -> laneCount.toString)
     ).flatten
     environment.foreach { (pair) =>
       processBuilder.environment().put(pair._1, pair._2)
     }
+    val startTime = System.nanoTime()
     val process = processBuilder.start()
     val controller = new Simulation.Controller(
       new BufferedWriter(new OutputStreamWriter(process.getOutputStream())),
@@ -46,17 +62,26 @@ final class Simulation private[svsim] (
       logMessagesAndCommands = verbose
     )
     try {
-      val outcome = body(controller)
-      // If the process is still running, give it an opportunity to shut down gracefully
-      controller.sendCommand(Simulation.Command.Done)
-      // Make sure errors are thrown from async commands at the end of the test
-      controller.completeInFlightCommands()
-      process.waitFor()
+      // Wait for the `READY` message so that process startup is not attributed to the body
+      PhaseTiming.measure("simulation/startup", reportPhaseTiming) {
+        controller.completeInFlightCommands()
+      }
+      val outcome = PhaseTiming.measure("simulation/body", reportPhaseTiming) {
+        body(controller)
+      }
+      PhaseTiming.measure("simulation/shutdown", reportPhaseTiming) {
+        // If the process is still running, give it an opportunity to shut down gracefully
+        controller.sendCommand(Simulation.Command.Done)
+        // Make sure errors are thrown from async commands at the end of the test
+        controller.completeInFlightCommands()
+        process.waitFor()
+      }
       if (process.exitValue() != 0) {
         throw new Exception(s"Nonzero exit status: ${process.exitValue()}")
       }
       outcome
     } finally {
+      reportPhaseTiming(PhaseTiming("simulation", System.nanoTime() - startTime))
       process.destroyForcibly()
     }
   }
@@ -86,15 +111,30 @@ object Simulation {
       new String(array)
     }
 
+    private var onHeartbeat: Simulation.Message.Heartbeat => Unit = _ => ()
+
+    // Heartbeats are unsolicited, so they are handled here rather than by the expectation of any particular command
+    @tailrec
+    private def readNextAvailableMessage(): Simulation.Message = {
+      readNextMessage() match {
+        case heartbeat: Simulation.Message.Heartbeat =>
+          onHeartbeat(heartbeat)
+          readNextAvailableMessage()
+        case message => message
+      }
+    }
+
     private var readMessageCount = 0
     // For specific message formats, consult `simulation-driver.cpp`
-    private def readNextAvailableMessage(): Simulation.Message = {
+    private def readNextMessage(): Simulation.Message = {
       object MessageCode {
         val Ready = 'r'
         val Error = 'e'
         val Ack = 'k'
         val Bits = 'b'
         val Log = 'l'
+        val Heartbeat = 'h'
+        val Watchdog = 'w'
       }
 
       def readChar(): Option[Char] = {
@@ -154,13 +194,30 @@ object Simulation {
           mustRead('\n')
           Log(new String(content))
         }
+        case MessageCode.Heartbeat => {
+          val Array(cyclesElapsed, cyclesPerSecond) = messageReader.readLine().split(' ')
+          Heartbeat(BigInt(cyclesElapsed, 16), BigInt(cyclesPerSecond, 16))
+        }
+        case MessageCode.Watchdog => {
+          readMessageCount += 1
+          throw new WatchdogExpired(BigInt(messageReader.readLine(), 16))
+        }
         case _ => throw new Exception(s"Unknown message code: ${messageCode}")
       }
-      if (logMessagesAndCommands) {
-        // NOTE: Commands are 1-indexed, but messages are 0-indexed since we read the first message (READY) before we send any commands.
-        println(s"Received message ${readMessageCount}: ${message}")
+      message match {
+        // Heartbeats are not replies to commands, so they are not numbered like other messages (the simulation does not
+        // count them in its execution script either)
+        case _: Heartbeat =>
+          if (logMessagesAndCommands) {
+            println(s"Received heartbeat: ${message}")
+          }
+        case _ =>
+          if (logMessagesAndCommands) {
+            // NOTE: Commands are 1-indexed, but messages are 0-indexed since we read the first message (READY) before we send any commands.
+            println(s"Received message ${readMessageCount}: ${message}")
+          }
+          readMessageCount += 1
       }
-      readMessageCount += 1
       message
     }
 
@@ -169,26 +226,36 @@ object Simulation {
     def completeInFlightCommands() = {
       commandWriter.flush()
 
-      expectations.foreach { f =>
-        val message = readNextAvailableMessage()
-        if (f.isDefinedAt(message)) {
-          f(message)
-        } else {
-          throw new Exception(s"Unexpected message: ${message}")
+      // An expired watchdog replaces the reply to a single command, and the simulation still replies to the commands
+      // after it, so those replies are read before the expiry is thrown. Otherwise, later commands would read them.
+      var watchdogExpired: Option[Simulation.Message.WatchdogExpired] = None
+      try {
+        while (expectations.nonEmpty) {
+          val f = expectations.dequeue()
+          try {
+            val message = readNextAvailableMessage()
+            if (f.isDefinedAt(message)) {
+              f(message)
+            } else {
+              throw new Exception(s"Unexpected message: ${message}")
+            }
+          } catch {
+            case expired: Simulation.Message.WatchdogExpired if watchdogExpired.isEmpty =>
+              watchdogExpired = Some(expired)
+          }
         }
+      } finally {
+        expectations.clear()
       }
-      expectations.clear()
+      watchdogExpired.foreach(throw _)
     }
 
     private[Simulation] def processNextMessage[A](f: PartialFunction[Simulation.Message, A]): A = {
+      // The message is expected like any other, so that it is still read if an earlier command's watchdog expired
+      var result: Option[A] = None
+      expectations.enqueue(f.andThen(value => result = Some(value)))
       completeInFlightCommands()
-
-      val message = readNextAvailableMessage()
-      if (f.isDefinedAt(message)) {
-        f(message)
-      } else {
-        throw new Exception(s"Unexpected message: ${message}")
-      }
+      result.get
     }
 
     private[Simulation] def expectNextMessage(f: PartialFunction[Simulation.Message, Unit]) = {
@@ -209,6 +276,9 @@ object Simulation {
         val Run = 'R'
         val Tick = 'T'
         val Trace = 'W'
+        val SelectLane = 'A'
+        val Heartbeat = 'H'
+        val Watchdog = 'M'
       };
 
       sentCommandCount += 1
@@ -245,7 +315,7 @@ object Simulation {
           commandWriter.write(" ")
           commandWriter.write(timesteps.toHexString)
         }
-        case Tick(id, inPhaseValue, outOfPhaseValue, timestepsPerPhase, maxCycles, sentinel) => {
+        case Tick(id, inPhaseValue, outOfPhaseValue, timestepsPerPhase, maxCycles, sentinel, quiescence) => {
           commandWriter.write(CommandCode.Tick)
           commandWriter.write(" ")
           commandWriter.write(id)
@@ -266,12 +336,36 @@ object Simulation {
             }
             case None =>
           }
+          quiescence match {
+            case Some(Quiescence(cycles, watchedPorts)) => {
+              commandWriter.write(" ~")
+              commandWriter.write(cycles.toHexString)
+              commandWriter.write("@")
+              commandWriter.write(watchedPorts.map(_.id).mkString(","))
+            }
+            case None =>
+          }
         }
         case Trace(enable) => {
           commandWriter.write(CommandCode.Trace)
           commandWriter.write(" ")
           commandWriter.write(if (enable) "1" else "0")
         }
+        case SelectLane(lane) => {
+          commandWriter.write(CommandCode.SelectLane)
+          commandWriter.write(" ")
+          commandWriter.write(lane.toHexString)
+        }
+        case Heartbeat(intervalMillis) => {
+          commandWriter.write(CommandCode.Heartbeat)
+          commandWriter.write(" ")
+          commandWriter.write(intervalMillis.toHexString)
+        }
+        case Watchdog(limitMillis) => {
+          commandWriter.write(CommandCode.Watchdog)
+          commandWriter.write(" ")
+          commandWriter.write(limitMillis.toHexString)
+        }
       }
       commandWriter.newLine()
     }
@@ -294,6 +388,30 @@ object Simulation {
       expectNextMessage { case Simulation.Message.Ack => }
     }
 
+    /** Selects the lane which subsequent commands (other than `readLog`) apply to. Lanes are numbered from 0 to `laneCount - 1`, and lane 0 is selected when the simulation starts.
+      */
+    def selectLane(lane: Int): Unit = {
+      sendCommand(Simulation.Command.SelectLane(lane))
+      expectNextMessage { case Simulation.Message.Ack => }
+    }
+
+    /** Requests that the simulation report its progress every `intervalMillis` milliseconds while a `tick` is running. Heartbeats are passed to `onHeartbeat` as they are received, which happens whenever the controller is waiting on the simulation (for instance, while waiting for the result of a long `tick`). An interval of 0 disables heartbeats.
+      */
+    def setHeartbeat(intervalMillis: Int)(onHeartbeat: Simulation.Message.Heartbeat => Unit): Unit = {
+      require(intervalMillis >= 0, "Heartbeat interval must not be negative")
+      this.onHeartbeat = onHeartbeat
+      sendCommand(Simulation.Command.Heartbeat(intervalMillis))
+      expectNextMessage { case Simulation.Message.Ack => }
+    }
+
+    /** Limits the wall-clock time of each subsequent command to `limitMillis` milliseconds. A `tick` which exceeds the limit is stopped early, and a `Simulation.Message.WatchdogExpired` carrying the number of cycles which did elapse is thrown when its result is processed; the simulation can continue to be used afterwards. A command which cannot be stopped early and takes more than twice the limit causes the simulation to exit with an error. A limit of 0 disables the watchdog.
+      */
+    def setWatchdog(limitMillis: Int): Unit = {
+      require(limitMillis >= 0, "Watchdog limit must not be negative")
+      sendCommand(Simulation.Command.Watchdog(limitMillis))
+      expectNextMessage { case Simulation.Message.Ack => }
+    }
+
     private val portInfos = moduleInfo.ports.zipWithIndex.map {
       case (port, index) =>
         port.name -> (index.toHexString, port)
@@ -315,6 +433,10 @@ object Simulation {
     case class Error(message: String) extends Throwable(message) with Message
     case class Bits(count: Int, value: BigInt) extends Message
     case class Log(message: String) extends Message
+    case class Heartbeat(cyclesElapsed: BigInt, cyclesPerSecond: BigInt) extends Message
+    case class WatchdogExpired(cyclesElapsed: BigInt)
+        extends Throwable(s"Watchdog expired after ${cyclesElapsed} cycles")
+        with Message
   }
 
   case class UnexpectedEndOfMessages() extends Exception
@@ -332,13 +454,27 @@ object Simulation {
       outOfPhaseValue:   BigInt,
       timestepsPerPhase: Int,
       maxCycles:         Int,
-      sentinel:          Option[(Port, BigInt)])
+      sentinel:          Option[(Port, BigInt)],
+      quiescence:        Option[Quiescence] = None)
         extends Command
     case class Trace(enable: Boolean) extends Command
+    case class SelectLane(lane: Int) extends Command
+    case class Heartbeat(intervalMillis: Int) extends Command
+    case class Watchdog(limitMillis: Int) extends Command
   }
 
   final case class Value(bitCount: Int, asBigInt: BigInt)
 
+  /** Allows a `tick` to skip the remainder of its cycles once the design is idle, which is the case when the values of `watchedPorts` have not changed for `cycles` consecutive cycles. Skipped cycles advance simulation time without toggling the clock, and are included in the elapsed cycle count.
+    *
+    * @note This is only correct if `watchedPorts` cover all of the state which can change while the design is idle (for instance, a timer counting towards a wake-up event must be watched, which means the design is never considered idle while it is counting), and the design's inputs are not changed by the body of the `tick`. The sentinel, if any, is checked before quiescence, so it acts as the wake condition.
+    */
+  final case class Quiescence(cycles: Int, watchedPorts: Seq[Port]) {
+    require(cycles > 0, "Quiescent cycle count must be greater than 0")
+    require(watchedPorts.nonEmpty, "At least one port must be watched to detect quiescence")
+    require(watchedPorts.forall(_.info.isGettable), "Watched ports must be gettable")
+  }
+
   final case class Port private[Simulation] (controller: Simulation.Controller, id: String, info: ModuleInfo.Port) {
 
     def set(value: BigInt) = {
@@ -370,10 +506,11 @@ object Simulation {
       maxCycles:         Int,
       inPhaseValue:      BigInt,
       outOfPhaseValue:   BigInt,
-      sentinel:          Option[(Port, BigInt)]
+      sentinel:          Option[(Port, BigInt)],
+      quiescence:        Option[Quiescence] = None
     ): BigInt = {
       controller.sendCommand(
-        Simulation.Command.Tick(id, inPhaseValue, outOfPhaseValue, timestepsPerPhase, maxCycles, sentinel)
+        Simulation.Command.Tick(id, inPhaseValue, outOfPhaseValue, timestepsPerPhase, maxCycles, sentinel, quiescence)
       )
       controller.processNextMessage {
         case Simulation.Message.Bits(_, cyclesElapsed) =>
@@ -0,0 +1,73 @@
+// SPDX-License-Identifier: Apache-2.0
+
+package svsim
+
+import java.io.File
+import java.nio.file.{Files, StandardCopyOption}
+import java.security.MessageDigest
+
+/** A content-addressed cache of compiled simulation executables, used by `Workspace.compile` when `CommonCompilationSettings.simulationCache` is set.
+  *
+  * Entries are keyed by the backend's version, the compiler invocation and the contents of every source file, so any change which could affect the compiled simulation results in a different entry. Entries are written to a temporary file and atomically moved into place, so they may be shared by concurrent processes.
+  */
+private[svsim] object SimulationCache {
+
+  /** @param sourceFiles Source files as passed to the compiler (relative to `workingDirectoryPath`).
+    */
+  def key(
+    backendVersion:       String,
+    invocationSettings:   Backend.InvocationSettings,
+    workspacePath:        String,
+    workingDirectoryPath: String,
+    sourceFiles:          Seq[String]
+  ): String = {
+    val digest = MessageDigest.getInstance("SHA-256")
+    def update(bytes: Array[Byte]) = {
+      digest.update(bytes)
+      digest.update(0.toByte)
+    }
+    // Each workspace has its own working directory, which does not affect the compiled simulation
+    def updateString(string: String) = update(
+      string
+        .replace(workingDirectoryPath, "$WORKING_DIRECTORY")
+        .replace(workspacePath, "$WORKSPACE")
+        .getBytes("UTF-8")
+    )
+
+    updateString(backendVersion)
+    updateString(invocationSettings.compilerPath)
+    invocationSettings.compilerArguments.foreach(updateString)
+    invocationSettings.compilerEnvironment.foreach { case (name, value) => updateString(s"$name=$value") }
+    sourceFiles.sorted.foreach { sourceFile =>
+      updateString(sourceFile)
+      update(Files.readAllBytes(new File(workingDirectoryPath, sourceFile).toPath()))
+    }
+    digest.digest().map("%02x".format(_)).mkString
+  }
+
+  /** Copies the cached executable for `key` to `destination`, returning `false` if there is no such entry.
+    */
+  def restore(cachePath: String, key: String, destination: File): Boolean = {
+    val entry = new File(cachePath, key)
+    if (!entry.exists()) {
+      false
+    } else {
+      Files.copy(entry.toPath(), destination.toPath(), StandardCopyOption.REPLACE_EXISTING)
+      destination.setExecutable(true)
+      true
+    }
+  }
+
+  def store(cachePath: String, key: String, executable: File): Unit = {
+    val cacheDirectory = new File(cachePath)
+    cacheDirectory.mkdirs()
+    val stagedEntry = Files.createTempFile(cacheDirectory.toPath(), s"$key.staging-", "")
+    try {
+      Files.copy(executable.toPath(), stagedEntry, StandardCopyOption.REPLACE_EXISTING)
+      // Concurrent processes may store the same entry, in which case either copy is equally valid
+      Files.move(stagedEntry, new File(cacheDirectory, key).toPath(), StandardCopyOption.ATOMIC_MOVE)
+    } finally {
+      Files.deleteIfExists(stagedEntry)
+    }
+  }
+}
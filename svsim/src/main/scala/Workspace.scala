@@ -260,12 +260,14 @@ final class Workspace(
     customSimulationWorkingDirectory: Option[String],
     verbose:                          Boolean
   ): Simulation = {
+    val compilationStartTime = System.nanoTime()
     val moduleInfo = _moduleInfo.get
     val workingDirectoryPath = s"$absolutePath/$workingDirectoryPrefix-$workingDirectoryTag"
     val workingDirectory = new File(workingDirectoryPath)
     workingDirectory.mkdir()
 
     val invocationSettings = backend.invocationSettings(
+      workspacePath = absolutePath,
       outputBinaryName = "simulation",
       topModuleName = Workspace.testbenchModuleName,
       additionalHeaderPaths = Seq(workingDirectoryPath),
@@ -280,7 +282,9 @@ final class Workspace(
     val simulationEnvironment = Seq(
       "SVSIM_SIMULATION_LOG" -> s"$workingDirectoryPath/simulation-log.txt",
       // The simulation driver appends the appropriate extension to the file path
-      "SVSIM_SIMULATION_TRACE" -> s"$workingDirectoryPath/trace"
+      "SVSIM_SIMULATION_TRACE" -> s"$workingDirectoryPath/trace",
+      // Records of printfs lowered to binary records, see `chisel3.stage.BinaryPrintfAnnotation`
+      "SVSIM_BINARY_PRINTF" -> s"$workingDirectoryPath/binary-printf.bin"
     ) ++ invocationSettings.simulationEnvironment
 
     // Emit Makefile for debugging (will be emitted even if compile fails)
@@ -351,42 +355,70 @@ final class Workspace(
       makefileWriter.close()
     }
 
-    /**
-      * Use the generated Makefile to compile the simulation, since this exercises the Makefile codepath and makes it less likely that we will break `make replay`.
-      */
-    val processBuilder = new ProcessBuilder("make", "-C", workingDirectoryPath, "simulation")
-    processBuilder.redirectErrorStream(true)
-    val process = processBuilder.start()
-    @scala.annotation.nowarn(
-      "msg=Use `scala.jdk.CollectionConverters` instead"
-    )
-    def readLogLines() = {
-      val sourceLocationRegex = "[\\./]*generated-sources/".r
-      import scala.collection.JavaConverters._
-      new BufferedReader(new InputStreamReader(process.getInputStream()))
-        .lines()
-        .map(sourceLocationRegex.replaceFirstIn(_, ""))
-        .map { line =>
-          if (verbose) {
-            println(line)
-          }
-          line
-        }
-        .iterator()
-        .asScala
-        .toSeq
+    val simulationCacheEntry = for {
+      cache <- commonSettings.simulationCache
+      version <- backend.simulationCacheVersion
+    } yield (cache.path, SimulationCache.key(version, invocationSettings, absolutePath, workingDirectoryPath, sourceFiles))
+    val restoreStartTime = System.nanoTime()
+    val restoredFromCache = simulationCacheEntry.exists {
+      case (cachePath, key) => SimulationCache.restore(cachePath, key, new File(workingDirectory, "simulation"))
     }
-    val compilationLogLines = readLogLines()
-    process.waitFor()
-    val compilationLogWriter = new PrintWriter(
-      new BufferedWriter(
-        new FileWriter(new File(s"$workingDirectoryPath/compilation-log.txt"))
+
+    val compilationPhaseTimings = if (restoredFromCache) {
+      val restoreEndTime = System.nanoTime()
+      Seq(
+        PhaseTiming("compilation", restoreEndTime - compilationStartTime),
+        PhaseTiming("compilation/restore-from-cache", restoreEndTime - restoreStartTime)
       )
-    )
-    compilationLogLines.foreach(compilationLogWriter.println)
-    compilationLogWriter.close()
-    if (process.exitValue() != 0) {
-      throw new Exception(compilationLogLines.mkString("\n"))
+    } else {
+      /**
+        * Use the generated Makefile to compile the simulation, since this exercises the Makefile codepath and makes it less likely that we will break `make replay`.
+        */
+      val backendStartTime = System.nanoTime()
+      val processBuilder = new ProcessBuilder("make", "-C", workingDirectoryPath, "simulation")
+      processBuilder.redirectErrorStream(true)
+      val process = processBuilder.start()
+      @scala.annotation.nowarn(
+        "msg=Use `scala.jdk.CollectionConverters` instead"
+      )
+      def readLogLines() = {
+        val sourceLocationRegex = "[\\./]*generated-sources/".r
+        import scala.collection.JavaConverters._
+        new BufferedReader(new InputStreamReader(process.getInputStream()))
+          .lines()
+          .map(sourceLocationRegex.replaceFirstIn(_, ""))
+          .map { line =>
+            if (verbose) {
+              println(line)
+            }
+            line
+          }
+          .iterator()
+          .asScala
+          .toSeq
+      }
+      val compilationLogLines = readLogLines()
+      process.waitFor()
+      val backendEndTime = System.nanoTime()
+      val compilationLogWriter = new PrintWriter(
+        new BufferedWriter(
+          new FileWriter(new File(s"$workingDirectoryPath/compilation-log.txt"))
+        )
+      )
+      compilationLogLines.foreach(compilationLogWriter.println)
+      compilationLogWriter.close()
+      if (process.exitValue() != 0) {
+        throw new Exception(compilationLogLines.mkString("\n"))
+      }
+      simulationCacheEntry.foreach {
+        case (cachePath, key) => SimulationCache.store(cachePath, key, new File(workingDirectory, "simulation"))
+      }
+      Seq(
+        PhaseTiming("compilation", backendEndTime - compilationStartTime),
+        PhaseTiming("compilation/backend", backendEndTime - backendStartTime)
+      ) ++ backend.compilationPhaseTimings(compilationLogLines).map { timing =>
+        timing.copy(name = s"compilation/backend/${timing.name}")
+      }
     }
 
     new Simulation(
@@ -397,7 +429,9 @@ final class Workspace(
         environment = simulationEnvironment.toMap
       ),
       workingDirectoryPath = workingDirectoryPath,
-      moduleInfo = moduleInfo
+      moduleInfo = moduleInfo,
+      compilationPhaseTimings = compilationPhaseTimings,
+      compilationStatistics = if (restoredFromCache) Seq() else backend.compilationStatistics(workingDirectoryPath)
     )
   }
 
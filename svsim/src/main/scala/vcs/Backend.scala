@@ -91,6 +91,7 @@ final class Backend(
   type CompilationSettings = Backend.CompilationSettings
 
   private[svsim] def invocationSettings(
+    workspacePath:           String,
     outputBinaryName:        String,
     topModuleName:           String,
     additionalHeaderPaths:   Seq[String],
@@ -110,9 +111,16 @@ final class Backend(
     //format: off
     import CommonCompilationSettings._
     import Backend.CompilationSettings._
+    // With shared parallelism, the compiler is run by the wrapper which claims its job slot
+    val (compilerPath, compilerPrefix, jobSlotsEnvironment) = commonSettings.availableParallelism match {
+      case AvailableParallelism.SharedAcrossProcesses(maxJobs, slotDirectory) =>
+        (JobSlots.wrapperPath(slotDirectory), Seq(s"$vcsHome/bin/vcs"), JobSlots.environment(maxJobs, slotDirectory))
+      case _ => (s"$vcsHome/bin/vcs", Seq(), Seq())
+    }
     svsim.Backend.InvocationSettings(
-      compilerPath = s"$vcsHome/bin/vcs",
+      compilerPath = compilerPath,
       compilerArguments = Seq[Seq[String]](
+        compilerPrefix,
         Seq(
           "-full64", // Enable 64-bit compilation
           "-sverilog", // Enable SystemVerilog
@@ -138,6 +146,8 @@ final class Backend(
         commonSettings.availableParallelism match {
           case AvailableParallelism.Default => Seq()
           case AvailableParallelism.UpTo(value) => Seq(s"-j${value}")
+          // The whole compilation runs in a single job slot
+          case AvailableParallelism.SharedAcrossProcesses(_, _) => Seq("-j1")
         },
         
         commonSettings.libraryExtensions match {
@@ -190,7 +200,7 @@ final class Backend(
       compilerEnvironment = environment ++ Seq(
         "VCS_HOME" -> vcsHome,
         "LM_LICENSE_FILE" -> lmLicenseFile,
-      ) ++ backendSpecificSettings.traceSettings.environment,
+      ) ++ backendSpecificSettings.traceSettings.environment ++ jobSlotsEnvironment,
       simulationArguments = Seq(
         backendSpecificSettings.simulationSettings.assertionSettings match {
           case None                                          => Seq()
@@ -11,6 +11,20 @@ object Backend {
     object TraceStyle {
       case class Vcd(traceUnderscore: Boolean = false) extends TraceStyle
     }
+
+    /** A directory in which the parts of the Verilator runtime which do not depend on the design (`verilated.cpp`, `verilated_dpi.cpp`, the VCD writer, etc.) are built once and then reused by subsequent compilations. The directory may be shared between concurrent processes.
+      */
+    case class RuntimeCache(path: String)
+
+    /** Wraps compilation of the Verilated C++ sources with a compiler cache such as `ccache` or `sccache`.
+      *
+      * `CCACHE_BASEDIR` is set to the root of the workspace, so that `ccache` rewrites paths within the workspace relative to the compilation directory, and identical sources compiled in different workspaces share cache entries.
+      *
+      * @param environment Additional environment variables configuring the compiler cache.
+      */
+    case class ObjectCache(
+      executable:  String = "ccache",
+      environment: Seq[(String, String)] = Seq())
   }
 
   case class CompilationSettings(
@@ -18,7 +32,10 @@ object Backend {
     outputSplit:                Option[Int] = None,
     outputSplitCFuncs:          Option[Int] = None,
     disabledWarnings:           Seq[String] = Seq(),
-    disableFatalExitOnWarnings: Boolean = false)
+    disableFatalExitOnWarnings: Boolean = false,
+    runtimeCache:               Option[CompilationSettings.RuntimeCache] = None,
+    objectCache:                Option[CompilationSettings.ObjectCache] = None,
+    reportStatistics:           Boolean = false)
 
   def initializeFromProcessEnvironment() = {
     val process = Runtime.getRuntime().exec(Array("which", "verilator"))
@@ -34,6 +51,7 @@ final class Backend(
   type CompilationSettings = Backend.CompilationSettings
 
   private[svsim] def invocationSettings(
+    workspacePath:           String,
     outputBinaryName:        String,
     topModuleName:           String,
     additionalHeaderPaths:   Seq[String],
@@ -43,6 +61,45 @@ final class Backend(
     import CommonCompilationSettings._
     import Backend.CompilationSettings._
     //format: off
+    val traceArguments = backendSpecificSettings.traceStyle match {
+      case Some(TraceStyle.Vcd(traceUnderscore)) => 
+        if (traceUnderscore) {
+          Seq("--trace", "--trace-underscore")
+        } else {
+          Seq("--trace")
+        }
+      case None => Seq()
+    }
+
+    // CFLAGS which do not depend on the location of the workspace, and are thus suitable for building the shared runtime.
+    val runtimeCFlags = Seq(
+      commonSettings.optimizationStyle match {
+        case OptimizationStyle.Default => Seq()
+        case OptimizationStyle.OptimizeForCompilationSpeed => Seq("-O1")
+      },
+
+      Seq("-std=c++11"),
+
+      Seq(
+        // Use verilator support
+        s"-D${svsim.Backend.enableVerilatorSupportFlag}",
+      ),
+
+      backendSpecificSettings.traceStyle match {
+        case Some(_) => Seq(s"-D${svsim.Backend.enableVerilatorTraceFlag}")
+        case None => Seq()
+      },
+    ).flatten
+
+    val prebuiltRuntimeLibrary = backendSpecificSettings.runtimeCache.map { cache =>
+      PrebuiltRuntime.libraryPath(
+        cachePath = cache.path,
+        executablePath = executablePath,
+        verilatorArguments = traceArguments,
+        cFlags = runtimeCFlags
+      )
+    }
+
     svsim.Backend.InvocationSettings(
       compilerPath = executablePath,
       compilerArguments = Seq[Seq[String]](
@@ -70,15 +127,7 @@ final class Backend(
           case None => Seq()
         },
 
-        backendSpecificSettings.traceStyle match {
-          case Some(TraceStyle.Vcd(traceUnderscore)) => 
-            if (traceUnderscore) {
-              Seq("--trace", "--trace-underscore")
-            } else {
-              Seq("--trace")
-            }
-          case None => Seq()
-        },
+        traceArguments,
 
         if (backendSpecificSettings.disableFatalExitOnWarnings) {
           Seq("-Wno-fatal")
@@ -87,6 +136,12 @@ final class Backend(
         },
         backendSpecificSettings.disabledWarnings.map("-Wno-" + _),
 
+        if (backendSpecificSettings.reportStatistics) {
+          Seq("--stats") // "Create statistics file", read by `compilationStatistics`
+        } else {
+          Seq()
+        },
+
         commonSettings.optimizationStyle match {
           case OptimizationStyle.Default => Seq()
           case OptimizationStyle.OptimizeForCompilationSpeed => Seq("-O1")
@@ -105,28 +160,24 @@ final class Backend(
             commonSettings.availableParallelism match {
               case AvailableParallelism.Default => Seq()
               case AvailableParallelism.UpTo(value) => Seq("-j", value.toString())
+              case AvailableParallelism.SharedAcrossProcesses(maxJobs, _) => Seq("-j", maxJobs.toString())
             },
-          ).flatten),
-          ("-CFLAGS", Seq(
-            commonSettings.optimizationStyle match {
-              case OptimizationStyle.Default => Seq()
-              case OptimizationStyle.OptimizeForCompilationSpeed => Seq("-O1")
+            // `OBJCACHE` prefixes every C++ compiler invocation in Verilator's generated Makefile
+            commonSettings.availableParallelism match {
+              // Each compiler invocation claims a job slot, and then runs the object cache (if any) itself
+              case AvailableParallelism.SharedAcrossProcesses(_, slotDirectory) =>
+                Seq(s"OBJCACHE=${JobSlots.wrapperPath(slotDirectory)}")
+              case _ => backendSpecificSettings.objectCache.map(cache => s"OBJCACHE=${cache.executable}").toSeq
             },
-
-            Seq("-std=c++11"),
-              
-            additionalHeaderPaths.map { path => s"-I${path}" },
-            
-            Seq(
-              // Use verilator support
-              s"-D${svsim.Backend.enableVerilatorSupportFlag}",
-            ),
-
-            backendSpecificSettings.traceStyle match {
-              case Some(_) => Seq(s"-D${svsim.Backend.enableVerilatorTraceFlag}")
+            prebuiltRuntimeLibrary match {
+              // Don't build the runtime objects, they are linked from the prebuilt library instead
+              case Some(_) => Seq("VK_GLOBAL_OBJS=")
               case None => Seq()
             },
-          ).flatten)
+          ).flatten),
+          ("-CFLAGS", runtimeCFlags ++ additionalHeaderPaths.map { path => s"-I${path}" }),
+          // Libraries specified via `-LDFLAGS` are linked after the model, so all runtime symbols the model references are resolved
+          ("-LDFLAGS", prebuiltRuntimeLibrary.toSeq),
         ).collect {
           /// Only include flags that have one or more values
           case (flag, value) if !value.isEmpty => {
@@ -144,10 +195,67 @@ final class Backend(
           },
         ).flatten.map(_.toCommandlineArgument),
       ).flatten,
-      compilerEnvironment = Seq(),
+      compilerEnvironment = Seq(
+        backendSpecificSettings.objectCache match {
+          case Some(ObjectCache(_, environment)) => Seq("CCACHE_BASEDIR" -> workspacePath) ++ environment
+          case None => Seq()
+        },
+        commonSettings.availableParallelism match {
+          case AvailableParallelism.SharedAcrossProcesses(maxJobs, slotDirectory) =>
+            JobSlots.environment(maxJobs, slotDirectory, backendSpecificSettings.objectCache.map(_.executable))
+          case _ => Seq()
+        },
+      ).flatten,
       simulationArguments = Seq(),
       simulationEnvironment = Seq()
     )
     //format: on
   }
+
+  /** Verilator ends its output with a summary of the form `- Verilator: Walltime 3.094 s (elab=0.013, cvt=0.103, bld=2.961); cpu 0.124 s on 1 threads; alloced 19.203 MB`, where `bld` is the time spent compiling and linking the generated C++.
+    */
+  private val reportRegex =
+    ".*Walltime [0-9.]+ s \\(elab=([0-9.]+), cvt=([0-9.]+), bld=([0-9.]+)\\).*?(?:alloced ([0-9.]+) MB.*)?".r
+
+  private lazy val version = PrebuiltRuntime.verilatorVersion(executablePath)
+  private[svsim] override def simulationCacheVersion: Option[String] = Some(version)
+
+  private[svsim] override def compilationPhaseTimings(compilationLog: Seq[String]): Seq[PhaseTiming] = {
+    def nanos(seconds: String) = (seconds.toDouble * 1e9).toLong
+    compilationLog.collectFirst {
+      case reportRegex(elaboration, conversion, build, allocatedMegabytes) =>
+        Seq(
+          PhaseTiming(
+            "verilator",
+            nanos(elaboration) + nanos(conversion),
+            Option(allocatedMegabytes).map { value => (value.toDouble * 1024 * 1024).toLong }
+          ),
+          PhaseTiming("verilator/elaboration", nanos(elaboration)),
+          PhaseTiming("verilator/conversion", nanos(conversion)),
+          PhaseTiming("cxx-build", nanos(build))
+        )
+    }.getOrElse(Seq())
+  }
+
+  /** `--stats` writes `V<top>__stats.txt`, whose "Global Statistics" section has one statistic per line, of the form `  Optimizations, Gate inputs replaced          12`.
+    */
+  private val statisticRegex = "\\s+(.*?)\\s{2,}(-?[0-9.]+)\\s*".r
+
+  private[svsim] override def compilationStatistics(workingDirectoryPath: String): Seq[(String, Double)] = {
+    val files = Option(new java.io.File(s"$workingDirectoryPath/verilated-sources").listFiles()).toSeq.flatten
+    files.filter(_.getName().endsWith("__stats.txt")).flatMap { file =>
+      val source = scala.io.Source.fromFile(file)
+      try {
+        source
+          .getLines()
+          .dropWhile(!_.startsWith("Global Statistics"))
+          .drop(1)
+          .takeWhile(line => line.isEmpty || line.startsWith(" "))
+          .collect { case statisticRegex(name, value) => name -> value.toDouble }
+          .toList
+      } finally {
+        source.close()
+      }
+    }
+  }
 }
@@ -0,0 +1,158 @@
+// SPDX-License-Identifier: Apache-2.0
+
+package svsim.verilator
+
+import java.io.{BufferedReader, File, InputStreamReader, RandomAccessFile}
+import java.nio.file.{Files, StandardCopyOption}
+import java.security.MessageDigest
+
+/** Builds and caches the parts of a Verilator simulation which do not depend on the design being simulated, such as `verilated.cpp`, `verilated_dpi.cpp` and the VCD writer.
+  *
+  * The runtime is built by verilating a trivial stub design using the same Verilator flags and `CFLAGS` as the real simulation, so the resulting objects are identical to the ones Verilator's generated Makefile would have built. These objects are then archived into a static library which subsequent compilations link against instead of rebuilding them. Cache entries are keyed by the Verilator version, the Verilator flags affecting the runtime, and the `CFLAGS`, and may be shared by concurrent processes.
+  */
+private[verilator] object PrebuiltRuntime {
+  val libraryName = "libsvsim-verilated.a"
+
+  private val stubModuleName = "svsimRuntimeStub"
+
+  /** Returns the path to a static library containing the Verilator runtime, building it if necessary.
+    */
+  def libraryPath(
+    cachePath:          String,
+    executablePath:     String,
+    verilatorArguments: Seq[String],
+    cFlags:             Seq[String]
+  ): String = synchronized {
+    val key = {
+      val digest = MessageDigest.getInstance("SHA-256")
+      val components = Seq(verilatorVersion(executablePath)) ++ verilatorArguments ++ Seq("-CFLAGS") ++ cFlags
+      digest.update(components.mkString("\n").getBytes("UTF-8"))
+      digest.digest().map("%02x".format(_)).mkString.take(16)
+    }
+    val cacheDirectory = new File(cachePath)
+    cacheDirectory.mkdirs()
+    val entryDirectory = new File(cacheDirectory, key)
+    val library = new File(entryDirectory, libraryName)
+
+    // `synchronized` serializes builds within this process, the file lock serializes builds across processes.
+    val lockFile = new RandomAccessFile(new File(cacheDirectory, s"$key.lock"), "rw")
+    try {
+      val lock = lockFile.getChannel().lock()
+      try {
+        if (!library.exists()) {
+          build(cacheDirectory, entryDirectory, executablePath, verilatorArguments, cFlags)
+        }
+      } finally {
+        lock.release()
+      }
+    } finally {
+      lockFile.close()
+    }
+    library.getAbsolutePath()
+  }
+
+  def verilatorVersion(executablePath: String): String = {
+    val (exitCode, output) = execute(Seq(executablePath, "--version"), new File("."))
+    if (exitCode != 0) {
+      throw new Exception(s"Failed to determine Verilator version:\n${output.mkString("\n")}")
+    }
+    output.mkString("\n")
+  }
+
+  private def build(
+    cacheDirectory:     File,
+    entryDirectory:     File,
+    executablePath:     String,
+    verilatorArguments: Seq[String],
+    cFlags:             Seq[String]
+  ): Unit = {
+    // Build in a staging directory which is atomically moved into place, so a partially built entry is never observed.
+    val stagingDirectory = Files.createTempDirectory(cacheDirectory.toPath(), s"${entryDirectory.getName()}.staging-").toFile()
+    try {
+      val stubSource = new svsim.LineWriter(s"$stagingDirectory/$stubModuleName.sv")
+      try {
+        val l = stubSource
+        l("module ", stubModuleName, ";")
+        // Importing a DPI function ensures `verilated_dpi.cpp` is part of the runtime
+        l("  import \"DPI-C\" function void ", stubModuleName, "_dpi();")
+        l("  initial ", stubModuleName, "_dpi();")
+        l("endmodule")
+      } finally {
+        stubSource.close()
+      }
+      val stubMain = new svsim.LineWriter(s"$stagingDirectory/$stubModuleName.cpp")
+      try {
+        val l = stubMain
+        l("#include \"V", stubModuleName, ".h\"")
+        l("#include \"verilated.h\"")
+        l()
+        l("extern \"C\" void ", stubModuleName, "_dpi() {}")
+        l()
+        l("int main(int argc, char **argv) {")
+        l("  VerilatedContext context;")
+        l("  V", stubModuleName, " stub{&context};")
+        l("  stub.eval();")
+        l("  stub.final();")
+        l("  return 0;")
+        l("}")
+      } finally {
+        stubMain.close()
+      }
+
+      //format: off
+      val (verilatorExitCode, verilatorOutput) = execute(
+        Seq(
+          executablePath,
+          "--cc",
+          "--exe",
+          "--build",
+          "-o", stubModuleName,
+          "--top-module", stubModuleName,
+          "--Mdir", "verilated-sources",
+        ) ++ verilatorArguments ++ (
+          if (cFlags.isEmpty) Seq() else Seq("-CFLAGS", cFlags.mkString(" "))
+        ) ++ Seq(
+          s"$stubModuleName.sv",
+          s"$stubModuleName.cpp"
+        ),
+        stagingDirectory
+      )
+      //format: on
+      if (verilatorExitCode != 0) {
+        throw new Exception(s"Failed to build Verilator runtime:\n${verilatorOutput.mkString("\n")}")
+      }
+
+      val runtimeObjects = new File(stagingDirectory, "verilated-sources")
+        .listFiles()
+        .map(_.getName())
+        .filter { name => name.startsWith("verilated") && name.endsWith(".o") }
+        .sorted
+      if (runtimeObjects.isEmpty) {
+        throw new Exception("Verilator did not build any runtime objects.")
+      }
+      val stagedEntryDirectory = new File(stagingDirectory, "entry")
+      stagedEntryDirectory.mkdir()
+      val (archiveExitCode, archiveOutput) = execute(
+        Seq("ar", "rcs", s"../entry/$libraryName") ++ runtimeObjects,
+        new File(stagingDirectory, "verilated-sources")
+      )
+      if (archiveExitCode != 0) {
+        throw new Exception(s"Failed to archive Verilator runtime:\n${archiveOutput.mkString("\n")}")
+      }
+
+      Files.move(stagedEntryDirectory.toPath(), entryDirectory.toPath(), StandardCopyOption.ATOMIC_MOVE)
+    } finally {
+      execute(Seq("rm", "-rf", stagingDirectory.getAbsolutePath()), cacheDirectory)
+    }
+  }
+
+  private def execute(command: Seq[String], workingDirectory: File): (Int, Seq[String]) = {
+    val processBuilder = new ProcessBuilder(command: _*)
+    processBuilder.directory(workingDirectory)
+    processBuilder.redirectErrorStream(true)
+    val process = processBuilder.start()
+    val reader = new BufferedReader(new InputStreamReader(process.getInputStream()))
+    val output = Iterator.continually(reader.readLine()).takeWhile(_ != null).toVector
+    (process.waitFor(), output)
+  }
+}
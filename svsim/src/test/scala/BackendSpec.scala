@@ -32,6 +32,107 @@ class VerilatorSpec extends BackendSpec {
   test("verilator", backend)(compilationSettings)
 }
 
+class VerilatorRuntimeCacheSpec extends BackendSpec {
+  import verilator.Backend.CompilationSettings._
+  val backend = verilator.Backend.initializeFromProcessEnvironment()
+  val compilationSettings = verilator.Backend.CompilationSettings(
+    traceStyle = Some(TraceStyle.Vcd(traceUnderscore = false)),
+    runtimeCache = Some(RuntimeCache(s"test_run_dir/${getClass().getSimpleName()}-runtime-cache"))
+  )
+  test("verilator", backend)(compilationSettings)
+}
+
+class VerilatorStatisticsSpec extends AnyFunSpec with Matchers {
+  describe("Svsim backend 'verilator' with statistics") {
+    it("reports statistics and allocations from the compilation") {
+      import Resources._
+      val workspace = new svsim.Workspace(path = s"test_run_dir/${getClass().getSimpleName()}")
+      workspace.reset()
+      workspace.elaborateGCD()
+      workspace.generateAdditionalSources()
+      val simulation = workspace.compile(
+        verilator.Backend.initializeFromProcessEnvironment()
+      )(
+        workingDirectoryTag = "verilator",
+        commonSettings = CommonCompilationSettings(),
+        backendSpecificSettings = verilator.Backend.CompilationSettings(reportStatistics = true),
+        customSimulationWorkingDirectory = None,
+        verbose = false
+      )
+      simulation.compilationStatistics must not be empty
+      simulation.compilationStatistics.map(_._2).foreach(_ must be >= 0.0)
+      val verilatorTiming = simulation.compilationPhaseTimings.find(_.name == "compilation/backend/verilator")
+      verilatorTiming.flatMap(_.allocatedBytes).getOrElse(0L) must be > 0L
+    }
+  }
+}
+
+class VerilatorLanesSpec extends AnyFunSpec with Matchers {
+  describe("Svsim backend 'verilator' with multiple lanes") {
+    it("simulates each lane independently") {
+      import Resources._
+      val workspace = new svsim.Workspace(path = s"test_run_dir/${getClass().getSimpleName()}")
+      workspace.reset()
+      workspace.elaborateGCD()
+      workspace.generateAdditionalSources()
+      val simulation = workspace.compile(
+        verilator.Backend.initializeFromProcessEnvironment()
+      )(
+        workingDirectoryTag = "verilator",
+        commonSettings = CommonCompilationSettings(),
+        backendSpecificSettings = verilator.Backend.CompilationSettings(),
+        customSimulationWorkingDirectory = None,
+        verbose = false
+      )
+      simulation.run(laneCount = 2) { controller =>
+        val clock = controller.port("clock")
+        val a = controller.port("a")
+        val b = controller.port("b")
+        val loadValues = controller.port("loadValues")
+        val isValid = controller.port("isValid")
+        val result = controller.port("result")
+        def tick(cycles: Int) =
+          clock.tick(timestepsPerPhase = 1, cycles = cycles, inPhaseValue = 0, outOfPhaseValue = 1)
+        def checkResult(expected: BigInt) = result.check { value =>
+          assert(value.asBigInt === expected)
+        }
+
+        // Load different values into each lane
+        for ((lane, (aValue, bValue)) <- Seq(0 -> (12, 18), 1 -> (35, 14))) {
+          controller.selectLane(lane)
+          a.set(aValue)
+          b.set(bValue)
+          loadValues.set(1)
+          tick(1)
+          loadValues.set(0)
+        }
+
+        // Only lane 0 advances while it is ticked
+        controller.selectLane(0)
+        tick(2)
+        checkResult(6)
+        controller.selectLane(1)
+        checkResult(35)
+
+        // Each lane calculates its own GCD
+        clock.tick(
+          inPhaseValue = 0,
+          outOfPhaseValue = 1,
+          timestepsPerPhase = 1,
+          maxCycles = 10,
+          sentinel = Some(isValid, 1)
+        )
+        checkResult(7)
+        controller.selectLane(0)
+        checkResult(6)
+        isValid.check { value =>
+          assert(value.asBigInt === 0)
+        }
+      }
+    }
+  }
+}
+
 trait BackendSpec extends AnyFunSpec with Matchers {
   def test[Backend <: svsim.Backend](
     name:                String,
@@ -144,6 +245,145 @@ trait BackendSpec extends AnyFunSpec with Matchers {
         val traceReader = new BufferedReader(new FileReader(s"${simulation.workingDirectoryPath}/trace.vcd"))
         traceReader.lines().count() must be > 1L
       }
+
+      it("fast-forwards through quiescent cycles") {
+        simulation.run() { controller =>
+          val clock = controller.port("clock")
+          val isValid = controller.port("isValid")
+          val result = controller.port("result")
+          controller.setTraceEnabled(true)
+
+          controller.port("a").set(12)
+          controller.port("b").set(18)
+          controller.port("loadValues").set(1)
+          clock.tick(timestepsPerPhase = 1, cycles = 1, inPhaseValue = 0, outOfPhaseValue = 1)
+          controller.port("loadValues").set(0)
+          clock.tick(
+            inPhaseValue = 0,
+            outOfPhaseValue = 1,
+            timestepsPerPhase = 1,
+            maxCycles = 100,
+            sentinel = Some(isValid, 1)
+          ) must be < BigInt(100)
+
+          // Once the GCD is calculated, none of the GCD's state changes
+          val cyclesElapsed = clock.tick(
+            inPhaseValue = 0,
+            outOfPhaseValue = 1,
+            timestepsPerPhase = 1,
+            maxCycles = 1000000,
+            sentinel = None,
+            quiescence = Some(Simulation.Quiescence(cycles = 4, watchedPorts = Seq(isValid, result)))
+          )
+          cyclesElapsed must be(BigInt(1000000))
+          isValid.get().asBigInt must be(1)
+          result.get().asBigInt must be(6)
+        }
+
+        // Each cycle which is not skipped toggles the clock twice, adding at least two lines to the trace
+        val traceReader = new BufferedReader(new FileReader(s"${simulation.workingDirectoryPath}/trace.vcd"))
+        try {
+          traceReader.lines().count() must be < 10000L
+        } finally {
+          traceReader.close()
+        }
+      }
+
+      it("stops long-running ticks with a watchdog and reports heartbeats") {
+        simulation.run() { controller =>
+          val clock = controller.port("clock")
+          val heartbeats = scala.collection.mutable.ArrayBuffer[Simulation.Message.Heartbeat]()
+          controller.setHeartbeat(intervalMillis = 10)(heartbeats += _)
+          controller.setWatchdog(limitMillis = 200)
+
+          val expired = intercept[Simulation.Message.WatchdogExpired] {
+            clock.tick(
+              inPhaseValue = 0,
+              outOfPhaseValue = 1,
+              timestepsPerPhase = 1,
+              maxCycles = Int.MaxValue,
+              sentinel = None
+            )
+          }
+          expired.cyclesElapsed must be > BigInt(0)
+          expired.cyclesElapsed must be < BigInt(Int.MaxValue)
+          heartbeats must not be empty
+          heartbeats.last.cyclesElapsed must be <= expired.cyclesElapsed
+
+          // The simulation remains usable after the watchdog expires
+          controller.setWatchdog(limitMillis = 0)
+          clock.tick(
+            inPhaseValue = 0,
+            outOfPhaseValue = 1,
+            timestepsPerPhase = 1,
+            maxCycles = 10,
+            sentinel = None
+          ) must be(BigInt(10))
+        }
+      }
+
+      it("completes in-flight commands when a watchdog expires") {
+        simulation.run() { controller =>
+          val clock = controller.port("clock")
+          val loadValues = controller.port("loadValues")
+          val result = controller.port("result")
+          controller.setWatchdog(limitMillis = 200)
+
+          controller.port("a").set(12)
+          controller.port("b").set(18)
+          loadValues.set(1)
+          clock.tick(timestepsPerPhase = 1, cycles = 1, inPhaseValue = 0, outOfPhaseValue = 1)
+          loadValues.set(0)
+          var cyclesChecked = false
+          clock.tick(
+            inPhaseValue = 0,
+            outOfPhaseValue = 1,
+            timestepsPerPhase = 1,
+            maxCycles = Int.MaxValue,
+            sentinel = None,
+            checkElapsedCycleCount = { _ => cyclesChecked = true }
+          )
+          // These commands are sent after the tick whose watchdog expires, and their replies must not be read by the
+          // commands which follow
+          var resultChecked = false
+          result.check { value =>
+            resultChecked = true
+            value.asBigInt must be(6)
+          }
+          loadValues.set(0)
+          intercept[Simulation.Message.WatchdogExpired] {
+            controller.completeInFlightCommands()
+          }
+          cyclesChecked must be(false)
+          resultChecked must be(true)
+
+          // The simulation remains usable after the watchdog expires
+          controller.setWatchdog(limitMillis = 0)
+          controller.port("a").set(35)
+          controller.port("b").set(14)
+          loadValues.set(1)
+          clock.tick(timestepsPerPhase = 1, cycles = 1, inPhaseValue = 0, outOfPhaseValue = 1)
+          loadValues.set(0)
+          clock.tick(
+            inPhaseValue = 0,
+            outOfPhaseValue = 1,
+            timestepsPerPhase = 1,
+            maxCycles = 100,
+            sentinel = Some(controller.port("isValid"), 1)
+          ) must be < BigInt(100)
+          result.get().asBigInt must be(7)
+        }
+      }
+
+      it("reports phase timings") {
+        val timings = scala.collection.mutable.ArrayBuffer[PhaseTiming]()
+        simulation.run(reportPhaseTiming = { timing => timings += timing }) { controller =>
+          controller.port("clock").set(0)
+        }
+        val phases = (simulation.compilationPhaseTimings ++ timings).map(_.name)
+        phases must contain allOf ("compilation", "compilation/backend", "simulation/startup", "simulation/body", "simulation")
+        PhaseTiming.summarize(timings).map(_.count).toSet must be(Set(1))
+      }
     }
   }
 }